@@ -4,12 +4,40 @@
 #include <map>
 #include <memory>
 #include <algorithm>
+#include <set>
+#include <iterator>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <cctype>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 
 using namespace std;
 
 // ===================== Part A & B: Classes =====================
 
+class Person;
+
+// Notified when a person's searchable fields change or the person goes away.
+class PersonObserver {
+public:
+    virtual ~PersonObserver() {}
+    virtual void personChanged(Person* person) = 0;
+    virtual void personDestroyed(Person* person) = 0;
+};
+
 class Person {
 protected:
     string name;
@@ -17,6 +45,13 @@ protected:
     string ID;
     string contact;
 
+private:
+    vector<PersonObserver*> observers; // usually zero or one
+
+    void notifyChanged() {
+        for (PersonObserver* observer : observers) observer->personChanged(this);
+    }
+
 public:
     Person(string name, int age, string ID, string contact) {
         setName(name);
@@ -25,12 +60,37 @@ public:
         this->contact = contact;
     }
 
-    virtual ~Person() {}
+    // Copies start detached; assignment keeps this object's observers and notifies them.
+    Person(const Person& other) : name(other.name), age(other.age), ID(other.ID), contact(other.contact) {}
+
+    Person& operator=(const Person& other) {
+        name = other.name;
+        age = other.age;
+        ID = other.ID;
+        contact = other.contact;
+        notifyChanged();
+        return *this;
+    }
+
+    virtual ~Person() {
+        vector<PersonObserver*> watching;
+        watching.swap(observers); // observers may call removeObserver() from personDestroyed()
+        for (PersonObserver* observer : watching) observer->personDestroyed(this);
+    }
+
+    void addObserver(PersonObserver* observer) {
+        if (find(observers.begin(), observers.end(), observer) == observers.end()) observers.push_back(observer);
+    }
+
+    void removeObserver(PersonObserver* observer) {
+        observers.erase(remove(observers.begin(), observers.end(), observer), observers.end());
+    }
 
     // Encapsulation: Setters with validation
     void setName(string name) {
         if (name.empty()) throw invalid_argument("Name cannot be empty.");
         this->name = name;
+        notifyChanged();
     }
 
     void setAge(int age) {
@@ -38,8 +98,15 @@ public:
         this->age = age;
     }
 
-    void setContact(string contact) { this->contact = contact; }
-    void setID(string ID) { this->ID = ID; }
+    void setContact(string contact) {
+        this->contact = contact;
+        notifyChanged();
+    }
+
+    void setID(string ID) {
+        this->ID = ID;
+        notifyChanged();
+    }
 
     // Getters
     string getName() const { return name; }
@@ -150,62 +217,1465 @@ public:
     }
 };
 
+// ===================== Grade Statistics =====================
+
+struct GradeSummary {
+    size_t count = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double lowest = 0.0;
+    double highest = 0.0;
+
+    double average() const { return count ? sum / count : 0.0; }
+
+    // Population variance; clamped because removals can leave tiny negative rounding error.
+    double variance() const {
+        if (count == 0) return 0.0;
+        double mean = average();
+        return max(0.0, sumSquares / count - mean * mean);
+    }
+};
+
+// ===================== GradeIndex Class =====================
+
+// Order-statistic treap over (grade, studentID). Every node knows the size of
+// its subtree, so rank, select and threshold counts are O(log n). Nodes live in
+// a pooled vector and are linked by index to avoid one allocation per grade.
+class GradeIndex {
+public:
+    struct Entry {
+        double grade;
+        string studentID;
+    };
+
+    // Positional iterator: dereference is a select() on the current rank,
+    // so it stays cheap to create and never copies entries out.
+    class iterator {
+    private:
+        const GradeIndex* index;
+        size_t pos;
+
+    public:
+        typedef bidirectional_iterator_tag iterator_category;
+        typedef Entry value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Entry* pointer;
+        typedef const Entry& reference;
+
+        iterator(const GradeIndex* index = nullptr, size_t pos = 0) : index(index), pos(pos) {}
+
+        reference operator*() const { return index->select(pos); }
+        pointer operator->() const { return &index->select(pos); }
+        iterator& operator++() { ++pos; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++pos; return tmp; }
+        iterator& operator--() { --pos; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --pos; return tmp; }
+        bool operator==(const iterator& other) const { return pos == other.pos && index == other.index; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+        size_t rank() const { return pos; }
+    };
+
+    template <typename It>
+    class Range {
+    private:
+        It first, last;
+        size_t count;
+
+    public:
+        Range(It first, It last, size_t count) : first(first), last(last), count(count) {}
+        It begin() const { return first; }
+        It end() const { return last; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+    };
+
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+
+private:
+    struct Node {
+        Entry entry;
+        unsigned priority;
+        size_t size;
+        int left, right;
+    };
+
+    vector<Node> nodes;
+    vector<int> freeSlots;
+    int root = -1;
+    unsigned seed = 2463534242u;
+
+    unsigned nextPriority() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    size_t sizeOf(int t) const { return t < 0 ? 0 : nodes[t].size; }
+
+    void update(int t) { nodes[t].size = 1 + sizeOf(nodes[t].left) + sizeOf(nodes[t].right); }
+
+    static bool less(const Entry& a, double grade, const string& studentID) {
+        return a.grade < grade || (a.grade == grade && a.studentID < studentID);
+    }
+
+    // Splits t into entries ordered before (grade, studentID) and the rest.
+    void split(int t, double grade, const string& studentID, int& l, int& r) {
+        if (t < 0) { l = r = -1; return; }
+        if (less(nodes[t].entry, grade, studentID)) {
+            split(nodes[t].right, grade, studentID, nodes[t].right, r);
+            l = t;
+        } else {
+            split(nodes[t].left, grade, studentID, l, nodes[t].left);
+            r = t;
+        }
+        update(t);
+    }
+
+    // Splits off the first k entries of t.
+    void splitAt(int t, size_t k, int& l, int& r) {
+        if (t < 0) { l = r = -1; return; }
+        if (sizeOf(nodes[t].left) < k) {
+            splitAt(nodes[t].right, k - sizeOf(nodes[t].left) - 1, nodes[t].right, r);
+            l = t;
+        } else {
+            splitAt(nodes[t].left, k, l, nodes[t].left);
+            r = t;
+        }
+        update(t);
+    }
+
+    int merge(int l, int r) {
+        if (l < 0) return r;
+        if (r < 0) return l;
+        if (nodes[l].priority > nodes[r].priority) {
+            nodes[l].right = merge(nodes[l].right, r);
+            update(l);
+            return l;
+        }
+        nodes[r].left = merge(l, nodes[r].left);
+        update(r);
+        return r;
+    }
+
+public:
+    size_t size() const { return sizeOf(root); }
+    bool empty() const { return root < 0; }
+
+    void insert(const string& studentID, double grade) {
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            nodes[slot] = Node{Entry{grade, studentID}, nextPriority(), 1, -1, -1};
+        } else {
+            slot = static_cast<int>(nodes.size());
+            nodes.push_back(Node{Entry{grade, studentID}, nextPriority(), 1, -1, -1});
+        }
+        int l, r;
+        split(root, grade, studentID, l, r);
+        root = merge(merge(l, slot), r);
+    }
+
+    bool erase(const string& studentID, double grade) {
+        int l, r, m;
+        split(root, grade, studentID, l, r);
+        splitAt(r, 1, m, r);
+        bool found = m >= 0 && nodes[m].entry.grade == grade && nodes[m].entry.studentID == studentID;
+        if (found) {
+            nodes[m].entry.studentID.clear();
+            freeSlots.push_back(m);
+        } else {
+            r = merge(m, r);
+        }
+        root = merge(l, r);
+        return found;
+    }
+
+    // k-th smallest entry, 0-based. k must be < size().
+    const Entry& select(size_t k) const {
+        int t = root;
+        while (true) {
+            size_t leftSize = sizeOf(nodes[t].left);
+            if (k < leftSize) {
+                t = nodes[t].left;
+            } else if (k == leftSize) {
+                return nodes[t].entry;
+            } else {
+                k -= leftSize + 1;
+                t = nodes[t].right;
+            }
+        }
+    }
+
+    // Number of entries with grade strictly below threshold.
+    size_t countBelow(double threshold) const {
+        size_t count = 0;
+        for (int t = root; t >= 0;) {
+            if (nodes[t].entry.grade < threshold) {
+                count += sizeOf(nodes[t].left) + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return count;
+    }
+
+    // Number of entries with grade strictly above threshold.
+    size_t countAbove(double threshold) const {
+        size_t atMost = 0;
+        for (int t = root; t >= 0;) {
+            if (nodes[t].entry.grade <= threshold) {
+                atMost += sizeOf(nodes[t].left) + 1;
+                t = nodes[t].right;
+            } else {
+                t = nodes[t].left;
+            }
+        }
+        return size() - atMost;
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+
+    Range<iterator> below(double threshold) const {
+        size_t n = countBelow(threshold);
+        return Range<iterator>(begin(), iterator(this, n), n);
+    }
+
+    // Highest k entries, best first.
+    Range<reverse_iterator> top(size_t k) const {
+        k = min(k, size());
+        return Range<reverse_iterator>(reverse_iterator(end()), reverse_iterator(iterator(this, size() - k)), k);
+    }
+
+    // Nearest-rank percentile, p in [0, 100].
+    double percentile(double p) const {
+        if (empty()) return 0.0;
+        size_t n = size();
+        size_t rank = static_cast<size_t>(ceil(p / 100.0 * n));
+        rank = min(max<size_t>(rank, 1), n);
+        return select(rank - 1).grade;
+    }
+
+    double median() const {
+        size_t n = size();
+        if (n == 0) return 0.0;
+        if (n % 2) return select(n / 2).grade;
+        return (select(n / 2 - 1).grade + select(n / 2).grade) / 2.0;
+    }
+};
+
+// ===================== GradeStats Class =====================
+
+// Running aggregates kept up to date on every insert/remove so that
+// summary queries never have to walk the grade map. The grade index is only
+// consulted when the current minimum or maximum is removed.
+class GradeStats {
+private:
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double lowest = 0.0;
+    double highest = 0.0;
+    GradeIndex ordered;
+
+public:
+    void add(const string& studentID, double grade) {
+        if (ordered.empty()) {
+            lowest = highest = grade;
+        } else {
+            lowest = min(lowest, grade);
+            highest = max(highest, grade);
+        }
+        sum += grade;
+        sumSquares += grade * grade;
+        ordered.insert(studentID, grade);
+    }
+
+    void remove(const string& studentID, double grade) {
+        if (!ordered.erase(studentID, grade)) return;
+        sum -= grade;
+        sumSquares -= grade * grade;
+        if (ordered.empty()) {
+            sum = sumSquares = lowest = highest = 0.0;
+            return;
+        }
+        if (grade == lowest) lowest = ordered.select(0).grade;
+        if (grade == highest) highest = ordered.select(ordered.size() - 1).grade;
+    }
+
+    const GradeIndex& index() const { return ordered; }
+
+    GradeSummary summary() const {
+        GradeSummary s;
+        s.count = ordered.size();
+        s.sum = sum;
+        s.sumSquares = sumSquares;
+        s.lowest = lowest;
+        s.highest = highest;
+        return s;
+    }
+};
+
+// ===================== Copy-on-Write Versions =====================
+
+// True if p is the only reference. The acquire fence pairs with the release
+// decrement of a snapshot dropped on another thread, so its reads finish
+// before the caller writes in place. ThreadSanitizer does not model fences
+// and flags those in-place writes as races.
+template <typename T>
+bool exclusiveOwner(const shared_ptr<T>& p) {
+    if (p.use_count() != 1) return false;
+    atomic_thread_fence(memory_order_acquire);
+    return true;
+}
+
+// Chunked array whose state can be handed out as an immutable version in
+// O(1). The single writer copies the chunk table, then a chunk, only the
+// first time it modifies them while some version still shares them, so with
+// no snapshot alive every write is in place. Versions are reference counted
+// and freed with the last snapshot holding them. The owner serializes writes
+// against snapshot(); readers of a version need no locking.
+template <typename T, size_t ChunkSize = 64>
+class CowVector {
+public:
+    struct Chunk {
+        T items[ChunkSize];
+    };
+
+    struct Version {
+        vector<shared_ptr<Chunk>> chunks;
+        size_t size = 0;
+
+        const T& operator[](size_t i) const { return chunks[i / ChunkSize]->items[i % ChunkSize]; }
+    };
+
+private:
+    shared_ptr<Version> current = make_shared<Version>();
+
+    Version& own() {
+        if (!exclusiveOwner(current)) current = make_shared<Version>(*current);
+        return *current;
+    }
+
+public:
+    size_t size() const { return current->size; }
+    const T& operator[](size_t i) const { return (*current)[i]; }
+
+    T& mutate(size_t i) {
+        shared_ptr<Chunk>& chunk = own().chunks[i / ChunkSize];
+        if (!exclusiveOwner(chunk)) chunk = make_shared<Chunk>(*chunk);
+        return chunk->items[i % ChunkSize];
+    }
+
+    void push_back(T value) {
+        Version& version = own();
+        if (version.size % ChunkSize == 0) version.chunks.push_back(make_shared<Chunk>());
+        mutate(version.size++) = move(value);
+    }
+
+    // Grows to at least n elements, default-constructing the new ones.
+    void resize(size_t n) {
+        while (size() < n) push_back(T());
+    }
+
+    shared_ptr<const Version> snapshot() const { return current; }
+};
+
 // ===================== GradeBook Class =====================
 
+// Immutable point-in-time view of a GradeBook: the records (one per student,
+// in first-graded order) plus the running summary, captured together.
+class GradeSnapshot {
+public:
+    typedef CowVector<GradeIndex::Entry>::Version Records;
+
+private:
+    shared_ptr<const Records> records;
+    GradeSummary totals;
+
+public:
+    GradeSnapshot(shared_ptr<const Records> records, const GradeSummary& totals) : records(move(records)), totals(totals) {}
+
+    size_t size() const { return records->size; }
+    const GradeIndex::Entry& operator[](size_t i) const { return (*records)[i]; }
+
+    GradeSummary getSummary() const { return totals; }
+    double calculateAverageGrade() const { return totals.average(); }
+
+    // Calls fn for records [first, last), so several threads can split one scan.
+    template <typename Fn>
+    void forEach(size_t first, size_t last, Fn fn) const {
+        for (size_t i = first; i < min(last, size()); ++i) fn((*records)[i]);
+    }
+
+    // In first-graded order, unlike GradeBook::getFailingStudents().
+    vector<string> getFailingStudents(double passGrade = 50.0) const {
+        vector<string> failing;
+        forEach(0, size(), [&](const GradeIndex::Entry& entry) {
+            if (entry.grade < passGrade) failing.push_back(entry.studentID);
+        });
+        return failing;
+    }
+};
+
 class GradeBook {
 private:
-    map<string, double> studentGrades;
+    map<string, uint32_t> slots; // studentID -> position in records
+    CowVector<GradeIndex::Entry> records;
+    GradeStats stats;
+    mutable mutex versionMutex; // orders writes against snapshot()
 
 public:
     void addGrade(const string& studentID, double grade) {
-        studentGrades[studentID] = grade;
+        lock_guard<mutex> guard(versionMutex);
+        auto it = slots.find(studentID);
+        if (it != slots.end()) {
+            GradeIndex::Entry& entry = records.mutate(it->second);
+            stats.remove(studentID, entry.grade);
+            entry.grade = grade;
+        } else {
+            slots.emplace(studentID, static_cast<uint32_t>(records.size()));
+            records.push_back(GradeIndex::Entry{grade, studentID});
+        }
+        stats.add(studentID, grade);
     }
 
-    double calculateAverageGrade() const {
-        if (studentGrades.empty()) return 0.0;
-        double total = 0;
-        for (const auto& entry : studentGrades)
-            total += entry.second;
-        return total / studentGrades.size();
+    // O(1); the view stays valid and unchanged while this GradeBook keeps taking
+    // writes, and may be read from any thread.
+    GradeSnapshot snapshot() const {
+        lock_guard<mutex> guard(versionMutex);
+        return GradeSnapshot(records.snapshot(), stats.summary());
     }
 
+    GradeSummary getSummary() const { return stats.summary(); }
+
+    double calculateAverageGrade() const { return stats.summary().average(); }
+
     double getHighestGrade() const {
-        double highest = 0.0;
-        for (const auto& entry : studentGrades)
-            if (entry.second > highest) highest = entry.second;
-        return highest;
+        GradeSummary s = stats.summary();
+        return s.count ? max(0.0, s.highest) : 0.0;
+    }
+
+    double getLowestGrade() const { return stats.summary().lowest; }
+
+    double getGradeVariance() const { return stats.summary().variance(); }
+
+    // Students strictly below passGrade, lowest grade first.
+    GradeIndex::Range<GradeIndex::iterator> failingStudents(double passGrade = 50.0) const {
+        return stats.index().below(passGrade);
     }
 
     vector<string> getFailingStudents(double passGrade = 50.0) const {
         vector<string> failing;
-        for (const auto& entry : studentGrades)
-            if (entry.second < passGrade) failing.push_back(entry.first);
+        for (const auto& entry : failingStudents(passGrade))
+            failing.push_back(entry.studentID);
         return failing;
     }
+
+    GradeIndex::Range<GradeIndex::reverse_iterator> getTopStudents(size_t k) const {
+        return stats.index().top(k);
+    }
+
+    // 1-based competition rank (ties share a rank); 0 if the student has no grade.
+    size_t getClassRank(const string& studentID) const {
+        auto it = slots.find(studentID);
+        if (it == slots.end()) return 0;
+        return stats.index().countAbove(records[it->second].grade) + 1;
+    }
+
+    // -1 if the student has no grade.
+    double getGrade(const string& studentID) const {
+        auto it = slots.find(studentID);
+        return it != slots.end() ? records[it->second].grade : -1.0;
+    }
+
+    double getPercentile(double p) const { return stats.index().percentile(p); }
+    double getMedianGrade() const { return stats.index().median(); }
+};
+
+// ===================== CourseGradeStats Class =====================
+
+// Per-course aggregates. Writers serialize on a mutex; readers go through a
+// seqlock on the published fields and never block a writer.
+class CourseGradeStats {
+private:
+    struct Slot {
+        map<string, double> grades;
+        GradeStats stats;
+
+        atomic<unsigned> sequence{0};
+        atomic<size_t> count{0};
+        atomic<double> sum{0.0}, sumSquares{0.0}, lowest{0.0}, highest{0.0};
+
+        void publish() {
+            GradeSummary s = stats.summary();
+            unsigned seq = sequence.load(memory_order_relaxed);
+            sequence.store(seq + 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+            count.store(s.count, memory_order_relaxed);
+            sum.store(s.sum, memory_order_relaxed);
+            sumSquares.store(s.sumSquares, memory_order_relaxed);
+            lowest.store(s.lowest, memory_order_relaxed);
+            highest.store(s.highest, memory_order_relaxed);
+            sequence.store(seq + 2, memory_order_release);
+        }
+
+        GradeSummary read() const {
+            GradeSummary s;
+            unsigned before, after;
+            do {
+                before = sequence.load(memory_order_acquire);
+                if (before & 1) continue;
+                s.count = count.load(memory_order_relaxed);
+                s.sum = sum.load(memory_order_relaxed);
+                s.sumSquares = sumSquares.load(memory_order_relaxed);
+                s.lowest = lowest.load(memory_order_relaxed);
+                s.highest = highest.load(memory_order_relaxed);
+                atomic_thread_fence(memory_order_acquire);
+                after = sequence.load(memory_order_relaxed);
+            } while ((before & 1) || before != after);
+            return s;
+        }
+    };
+
+    mutable mutex writeMutex;
+    map<string, unique_ptr<Slot>> courses; // slots are never freed, so readers may cache them
+
+    Slot& slotFor(const string& courseCode) {
+        auto& slot = courses[courseCode];
+        if (!slot) slot.reset(new Slot());
+        return *slot;
+    }
+
+public:
+    // Lock-free view of one course; resolve it once and poll it freely.
+    class Reader {
+    private:
+        const Slot* slot;
+
+    public:
+        explicit Reader(const Slot* slot) : slot(slot) {}
+        bool valid() const { return slot != nullptr; }
+        GradeSummary summary() const { return slot ? slot->read() : GradeSummary(); }
+    };
+
+    void addGrade(const string& courseCode, const string& studentID, double grade) {
+        lock_guard<mutex> lock(writeMutex);
+        Slot& slot = slotFor(courseCode);
+        auto it = slot.grades.find(studentID);
+        if (it != slot.grades.end()) {
+            slot.stats.remove(studentID, it->second);
+            it->second = grade;
+        } else {
+            slot.grades.emplace(studentID, grade);
+        }
+        slot.stats.add(studentID, grade);
+        slot.publish();
+    }
+
+    Reader reader(const string& courseCode) const {
+        lock_guard<mutex> lock(writeMutex);
+        auto it = courses.find(courseCode);
+        return Reader(it != courses.end() ? it->second.get() : nullptr);
+    }
+
+    GradeSummary getSummary(const string& courseCode) const {
+        return reader(courseCode).summary();
+    }
+};
+
+// ===================== Handle Registry =====================
+
+typedef uint32_t StudentHandle;
+typedef uint32_t CourseHandle;
+
+// Maps string keys (student IDs, course codes) to dense integer handles.
+// Keys are kept in a CowVector so snapshots can resolve handles to names.
+class HandleRegistry {
+private:
+    unordered_map<string, uint32_t> handles;
+    CowVector<string> keys;
+
+public:
+    static const uint32_t npos = UINT32_MAX;
+    typedef CowVector<string>::Version Keys;
+
+    uint32_t intern(const string& key) {
+        auto it = handles.find(key);
+        if (it != handles.end()) return it->second;
+        uint32_t handle = static_cast<uint32_t>(keys.size());
+        handles.emplace(key, handle);
+        keys.push_back(key);
+        return handle;
+    }
+
+    uint32_t find(const string& key) const {
+        auto it = handles.find(key);
+        return it != handles.end() ? it->second : npos;
+    }
+
+    const string& key(uint32_t handle) const { return keys[handle]; }
+    size_t size() const { return keys.size(); }
+    shared_ptr<const Keys> snapshot() const { return keys.snapshot(); }
+};
+
+// ===================== EnrollmentStore Class =====================
+
+// Course rosters keyed by handle. Each roster is a sparse set: a dense member
+// array plus a position map, so enroll, drop (swap-with-last) and membership
+// checks are O(1) and duplicate enrollments are rejected. A reverse index keeps
+// each student's courses as a small sorted array, updated on every enroll/drop.
+class EnrollmentStore {
+public:
+    typedef shared_ptr<vector<StudentHandle>> MemberList;
+    typedef CowVector<MemberList>::Version Members;
+
+private:
+    struct Roster {
+        unordered_map<StudentHandle, uint32_t> position;
+    };
+
+    vector<Roster> rosters;                  // indexed by CourseHandle
+    CowVector<MemberList> members;           // indexed by CourseHandle, versioned for snapshots
+    vector<vector<CourseHandle>> schedules;  // indexed by StudentHandle, sorted
+
+    const Roster* rosterFor(CourseHandle course) const {
+        return course < rosters.size() ? &rosters[course] : nullptr;
+    }
+
+    // The member array of a course, copied first if a snapshot still shares it.
+    vector<StudentHandle>& writableMembers(CourseHandle course) {
+        MemberList& list = members.mutate(course);
+        if (!list) list = make_shared<vector<StudentHandle>>();
+        else if (!exclusiveOwner(list)) list = make_shared<vector<StudentHandle>>(*list);
+        return *list;
+    }
+
+public:
+    bool enroll(CourseHandle course, StudentHandle student) {
+        if (course >= rosters.size()) {
+            rosters.resize(course + 1);
+            members.resize(course + 1);
+        }
+        Roster& roster = rosters[course];
+        vector<StudentHandle>& list = writableMembers(course);
+        if (!roster.position.emplace(student, static_cast<uint32_t>(list.size())).second)
+            return false;
+        list.push_back(student);
+        if (student >= schedules.size()) schedules.resize(student + 1);
+        vector<CourseHandle>& taking = schedules[student];
+        taking.insert(upper_bound(taking.begin(), taking.end(), course), course);
+        return true;
+    }
+
+    bool drop(CourseHandle course, StudentHandle student) {
+        if (course >= rosters.size()) return false;
+        Roster& roster = rosters[course];
+        auto it = roster.position.find(student);
+        if (it == roster.position.end()) return false;
+        uint32_t slot = it->second;
+        vector<StudentHandle>& list = writableMembers(course);
+        StudentHandle moved = list.back();
+        list[slot] = moved;
+        roster.position[moved] = slot;
+        list.pop_back();
+        roster.position.erase(student);
+        vector<CourseHandle>& taking = schedules[student];
+        taking.erase(lower_bound(taking.begin(), taking.end(), course));
+        return true;
+    }
+
+    shared_ptr<const Members> snapshot() const { return members.snapshot(); }
+
+    bool isEnrolled(CourseHandle course, StudentHandle student) const {
+        const Roster* roster = rosterFor(course);
+        return roster && roster->position.count(student) != 0;
+    }
+
+    size_t count(CourseHandle course) const { return students(course).size(); }
+
+    // Unordered; invalidated by the next enroll/drop on this course.
+    const vector<StudentHandle>& students(CourseHandle course) const {
+        static const vector<StudentHandle> none;
+        return course < members.size() && members[course] ? *members[course] : none;
+    }
+
+    // Sorted by handle.
+    const vector<CourseHandle>& courses(StudentHandle student) const {
+        static const vector<CourseHandle> none;
+        return student < schedules.size() ? schedules[student] : none;
+    }
+
+    // Walks the smaller roster and probes the larger one.
+    size_t sharedStudents(CourseHandle a, CourseHandle b, vector<StudentHandle>& out) const {
+        if (!rosterFor(a) || !rosterFor(b)) return 0;
+        if (count(a) > count(b)) swap(a, b);
+        const Roster* second = rosterFor(b);
+        size_t found = 0;
+        for (StudentHandle student : students(a)) {
+            if (second->position.count(student)) {
+                out.push_back(student);
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    // Bulk variants return how many pairs actually changed state.
+    size_t enrollAll(const vector<pair<CourseHandle, StudentHandle>>& batch) {
+        size_t changed = 0;
+        for (const auto& entry : batch)
+            if (enroll(entry.first, entry.second)) ++changed;
+        return changed;
+    }
+
+    size_t dropAll(const vector<pair<CourseHandle, StudentHandle>>& batch) {
+        size_t changed = 0;
+        for (const auto& entry : batch)
+            if (drop(entry.first, entry.second)) ++changed;
+        return changed;
+    }
 };
 
 // ===================== EnrollmentManager Class =====================
 
+// Immutable point-in-time view of an EnrollmentManager: every roster plus
+// the course codes and student IDs needed to name them.
+class EnrollmentSnapshot {
+private:
+    shared_ptr<const EnrollmentStore::Members> rosters;
+    shared_ptr<const HandleRegistry::Keys> courseKeys, studentKeys;
+
+    const vector<StudentHandle>& members(CourseHandle course) const {
+        static const vector<StudentHandle> none;
+        return course < rosters->size && (*rosters)[course] ? *(*rosters)[course] : none;
+    }
+
+public:
+    EnrollmentSnapshot(shared_ptr<const EnrollmentStore::Members> rosters, shared_ptr<const HandleRegistry::Keys> courseKeys,
+                       shared_ptr<const HandleRegistry::Keys> studentKeys)
+        : rosters(move(rosters)), courseKeys(move(courseKeys)), studentKeys(move(studentKeys)) {}
+
+    size_t courseCount() const { return courseKeys->size; }
+    const string& courseCode(CourseHandle course) const { return (*courseKeys)[course]; }
+    size_t getEnrollmentCount(CourseHandle course) const { return members(course).size(); }
+
+    // Linear in the number of courses; resolve once and use handles for repeated lookups.
+    CourseHandle findCourse(const string& courseCode) const {
+        for (CourseHandle course = 0; course < courseKeys->size; ++course)
+            if ((*courseKeys)[course] == courseCode) return course;
+        return HandleRegistry::npos;
+    }
+
+    int getEnrollmentCount(const string& courseCode) const {
+        CourseHandle course = findCourse(courseCode);
+        return course == HandleRegistry::npos ? 0 : static_cast<int>(getEnrollmentCount(course));
+    }
+
+    vector<string> getStudents(CourseHandle course) const {
+        vector<string> result;
+        for (StudentHandle student : members(course)) result.push_back((*studentKeys)[student]);
+        return result;
+    }
+};
+
+// Mutations may come from several threads: each one, including its handle
+// lookups, runs under versionMutex. The live accessors below (isEnrolled,
+// getEnrollmentCount, ...) take no lock and must not race with writers;
+// other threads read through snapshot().
 class EnrollmentManager {
 private:
-    map<string, vector<string>> courseEnrollments;
+    HandleRegistry courseHandles;
+    HandleRegistry studentHandles;
+    EnrollmentStore store;
+    mutable mutex versionMutex; // orders writes against snapshot()
 
 public:
-    void enrollStudent(const string& courseCode, const string& studentID) {
-        courseEnrollments[courseCode].push_back(studentID);
+    CourseHandle courseHandle(const string& courseCode) {
+        lock_guard<mutex> guard(versionMutex);
+        return courseHandles.intern(courseCode);
     }
 
-    void dropStudent(const string& courseCode, const string& studentID) {
-        auto& students = courseEnrollments[courseCode];
-        students.erase(remove(students.begin(), students.end(), studentID), students.end());
+    StudentHandle studentHandle(const string& studentID) {
+        lock_guard<mutex> guard(versionMutex);
+        return studentHandles.intern(studentID);
+    }
+
+    const string& courseCode(CourseHandle course) const { return courseHandles.key(course); }
+    const string& studentID(StudentHandle student) const { return studentHandles.key(student); }
+
+    // Returns false if the student was already enrolled.
+    bool enrollStudent(const string& courseCode, const string& studentID) {
+        lock_guard<mutex> guard(versionMutex);
+        return store.enroll(courseHandles.intern(courseCode), studentHandles.intern(studentID));
+    }
+
+    // Unknown courses or students are a no-op; nothing is created on a miss.
+    bool dropStudent(const string& courseCode, const string& studentID) {
+        lock_guard<mutex> guard(versionMutex);
+        CourseHandle course = courseHandles.find(courseCode);
+        StudentHandle student = studentHandles.find(studentID);
+        if (course == HandleRegistry::npos || student == HandleRegistry::npos) return false;
+        return store.drop(course, student);
+    }
+
+    // O(1); see GradeBook::snapshot().
+    EnrollmentSnapshot snapshot() const {
+        lock_guard<mutex> guard(versionMutex);
+        return EnrollmentSnapshot(store.snapshot(), courseHandles.snapshot(), studentHandles.snapshot());
+    }
+
+    bool isEnrolled(const string& courseCode, const string& studentID) const {
+        CourseHandle course = courseHandles.find(courseCode);
+        StudentHandle student = studentHandles.find(studentID);
+        if (course == HandleRegistry::npos || student == HandleRegistry::npos) return false;
+        return store.isEnrolled(course, student);
     }
 
     int getEnrollmentCount(const string& courseCode) const {
-        auto it = courseEnrollments.find(courseCode);
-        return (it != courseEnrollments.end()) ? it->second.size() : 0;
+        CourseHandle course = courseHandles.find(courseCode);
+        return course == HandleRegistry::npos ? 0 : static_cast<int>(store.count(course));
+    }
+
+    size_t enrollStudents(const vector<pair<string, string>>& batch) {
+        lock_guard<mutex> guard(versionMutex);
+        vector<pair<CourseHandle, StudentHandle>> handles;
+        handles.reserve(batch.size());
+        for (const auto& entry : batch)
+            handles.emplace_back(courseHandles.intern(entry.first), studentHandles.intern(entry.second));
+        return store.enrollAll(handles);
+    }
+
+    size_t dropStudents(const vector<pair<string, string>>& batch) {
+        lock_guard<mutex> guard(versionMutex);
+        vector<pair<CourseHandle, StudentHandle>> handles;
+        handles.reserve(batch.size());
+        for (const auto& entry : batch) {
+            CourseHandle course = courseHandles.find(entry.first);
+            StudentHandle student = studentHandles.find(entry.second);
+            if (course != HandleRegistry::npos && student != HandleRegistry::npos)
+                handles.emplace_back(course, student);
+        }
+        return store.dropAll(handles);
+    }
+
+    vector<string> getStudentCourses(const string& studentID) const {
+        vector<string> result;
+        StudentHandle student = studentHandles.find(studentID);
+        if (student == HandleRegistry::npos) return result;
+        for (CourseHandle course : store.courses(student))
+            result.push_back(courseHandles.key(course));
+        return result;
+    }
+
+    // Students enrolled in both courses, used for exam clash detection.
+    vector<string> getSharedStudents(const string& courseA, const string& courseB) const {
+        vector<string> result;
+        CourseHandle a = courseHandles.find(courseA);
+        CourseHandle b = courseHandles.find(courseB);
+        if (a == HandleRegistry::npos || b == HandleRegistry::npos) return result;
+        vector<StudentHandle> shared;
+        store.sharedStudents(a, b, shared);
+        for (StudentHandle student : shared)
+            result.push_back(studentHandles.key(student));
+        return result;
+    }
+
+    const EnrollmentStore& getStore() const { return store; }
+};
+
+// ===================== Mutation Journal =====================
+
+enum class JournalOp : uint8_t { SetGrade = 1, Enroll = 2, Drop = 3 };
+
+struct ReplayStats {
+    size_t records = 0;
+    size_t bytes = 0;          // valid prefix kept
+    size_t discardedBytes = 0; // torn or corrupt tail removed
+};
+
+// Append-only log of GradeBook and EnrollmentManager mutations. Each record is
+//   varint bodyLength | body | uint32 FNV-1a(body)
+// with body = op, then varint-length-prefixed strings: student ID followed by
+// the 8-byte double for grades, course code then student ID for enrollments. Appends only copy into a pending
+// buffer; commit() uses group commit: the first waiter whose record is not yet
+// durable becomes the leader, writes everything pending with one write() and
+// one fdatasync(), and wakes every writer the sync covered.
+class Journal {
+private:
+    int fd = -1;
+    string lastError;
+    mutex lock;
+    condition_variable durable;
+    string pending, flushing;
+    uint64_t appendedLsn = 0, durableLsn = 0;
+    bool syncing = false, failed = false;
+    uint64_t syncCount = 0;
+
+    static void putVarint(string& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    static bool getVarint(const char*& p, const char* end, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35 && p < end; shift += 7) {
+            uint8_t byte = static_cast<uint8_t>(*p++);
+            value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static void putString(string& out, const string& value) {
+        putVarint(out, static_cast<uint32_t>(value.size()));
+        out += value;
+    }
+
+    static bool getString(const char*& p, const char* end, string& value) {
+        uint32_t length;
+        if (!getVarint(p, end, length) || static_cast<size_t>(end - p) < length) return false;
+        value.assign(p, length);
+        p += length;
+        return true;
+    }
+
+    static uint32_t checksum(const char* data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+        return hash;
+    }
+
+    static void frame(string& out, const string& body) {
+        putVarint(out, static_cast<uint32_t>(body.size()));
+        out += body;
+        uint32_t sum = checksum(body.data(), body.size());
+        out.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+    }
+
+    bool writeAll(const string& data) {
+        size_t done = 0;
+        while (done < data.size()) {
+            ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+public:
+    Journal() {}
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    ~Journal() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    // Opens (or creates) the journal for appending. Run replay() first so a
+    // torn tail is cut off before new records follow it.
+    bool open(const string& path) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) lastError = "cannot open " + path + ": " + strerror(errno);
+        return fd >= 0;
+    }
+
+    static string gradeRecord(const string& studentID, double grade) {
+        string body(1, static_cast<char>(JournalOp::SetGrade)), out;
+        putString(body, studentID);
+        body.append(reinterpret_cast<const char*>(&grade), sizeof(grade));
+        frame(out, body);
+        return out;
+    }
+
+    static string enrollmentRecord(JournalOp op, const string& courseCode, const string& studentID) {
+        string body(1, static_cast<char>(op)), out;
+        putString(body, courseCode);
+        putString(body, studentID);
+        frame(out, body);
+        return out;
+    }
+
+    // Queues encoded records and returns the sequence number to commit().
+    uint64_t append(const string& records, size_t count = 1) {
+        lock_guard<mutex> guard(lock);
+        pending += records;
+        appendedLsn += count;
+        return appendedLsn;
+    }
+
+    // Blocks until every record up to lsn is on disk; false if the journal failed.
+    bool commit(uint64_t lsn) {
+        unique_lock<mutex> guard(lock);
+        while (durableLsn < lsn) {
+            if (failed) return false;
+            if (syncing) {
+                durable.wait(guard);
+                continue;
+            }
+            syncing = true;
+            flushing.swap(pending);
+            uint64_t upTo = appendedLsn;
+            guard.unlock();
+            bool ok = writeAll(flushing) && fdatasync(fd) == 0;
+            int savedErrno = errno;
+            flushing.clear();
+            guard.lock();
+            syncing = false;
+            if (ok) {
+                durableLsn = upTo;
+                ++syncCount;
+            } else {
+                failed = true;
+                lastError = string("journal write failed: ") + strerror(savedErrno);
+            }
+            durable.notify_all();
+        }
+        return true;
+    }
+
+    bool ok() {
+        lock_guard<mutex> guard(lock);
+        return fd >= 0 && !failed;
+    }
+
+    uint64_t getSyncCount() {
+        lock_guard<mutex> guard(lock);
+        return syncCount;
+    }
+
+    const string& error() const { return lastError; }
+
+    // Applies every intact record in order, then truncates the file after the
+    // last one, so a record torn by a crash is dropped rather than misread.
+    static ReplayStats replay(const string& path, GradeBook& gradeBook, EnrollmentManager& enrollment) {
+        ReplayStats stats;
+        int in = ::open(path.c_str(), O_RDWR);
+        if (in < 0) return stats;
+        string data;
+        char buffer[1 << 16];
+        for (;;) {
+            ssize_t n = ::read(in, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            data.append(buffer, static_cast<size_t>(n));
+        }
+
+        const char* p = data.data();
+        const char* end = p + data.size();
+        string first, second;
+        while (p < end) {
+            const char* record = p;
+            uint32_t length;
+            uint32_t sum;
+            if (!getVarint(p, end, length) || static_cast<size_t>(end - p) < size_t(length) + sizeof(sum) || length == 0) {
+                p = record;
+                break;
+            }
+            const char* body = p;
+            const char* bodyEnd = p + length;
+            memcpy(&sum, bodyEnd, sizeof(sum));
+            if (sum != checksum(body, length)) {
+                p = record;
+                break;
+            }
+            p = bodyEnd + sizeof(sum);
+
+            JournalOp op = static_cast<JournalOp>(*body++);
+            double grade;
+            bool valid = getString(body, bodyEnd, first);
+            if (valid && op == JournalOp::SetGrade && bodyEnd - body == sizeof(grade)) {
+                memcpy(&grade, body, sizeof(grade));
+                gradeBook.addGrade(first, grade);
+            } else if (valid && (op == JournalOp::Enroll || op == JournalOp::Drop) && getString(body, bodyEnd, second)) {
+                if (op == JournalOp::Enroll) enrollment.enrollStudent(first, second);
+                else enrollment.dropStudent(first, second);
+            } else {
+                p = record;
+                break;
+            }
+            ++stats.records;
+        }
+
+        stats.bytes = static_cast<size_t>(p - data.data());
+        stats.discardedBytes = data.size() - stats.bytes;
+        if (stats.discardedBytes && ftruncate(in, static_cast<off_t>(stats.bytes)) == 0) fdatasync(in);
+        ::close(in);
+        return stats;
     }
 };
 
+// Durable front end for GradeBook and EnrollmentManager. A mutation is
+// applied and journaled under one lock, so the journal order matches the
+// in-memory order, then waits for group commit outside the lock. Calls
+// return once the change is on disk.
+class DurableRegistrar {
+private:
+    GradeBook& gradeBook;
+    EnrollmentManager& enrollment;
+    Journal& journal;
+    mutex stateMutex;
+
+public:
+    DurableRegistrar(GradeBook& gradeBook, EnrollmentManager& enrollment, Journal& journal)
+        : gradeBook(gradeBook), enrollment(enrollment), journal(journal) {}
+
+    // False only if the journal failed; the in-memory change is then not durable.
+    bool setGrade(const string& studentID, double grade) {
+        string record = Journal::gradeRecord(studentID, grade);
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            gradeBook.addGrade(studentID, grade);
+            lsn = journal.append(record);
+        }
+        return journal.commit(lsn);
+    }
+
+    // Many grades under one commit; returns how many were made durable.
+    size_t setGrades(const vector<pair<string, double>>& batch) {
+        if (batch.empty()) return 0;
+        string records;
+        for (const auto& entry : batch) records += Journal::gradeRecord(entry.first, entry.second);
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            for (const auto& entry : batch) gradeBook.addGrade(entry.first, entry.second);
+            lsn = journal.append(records, batch.size());
+        }
+        return journal.commit(lsn) ? batch.size() : 0;
+    }
+
+    // No-ops (already enrolled, not enrolled) are not journaled and return false.
+    bool enrollStudent(const string& courseCode, const string& studentID) {
+        string record = Journal::enrollmentRecord(JournalOp::Enroll, courseCode, studentID);
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            if (!enrollment.enrollStudent(courseCode, studentID)) return false;
+            lsn = journal.append(record);
+        }
+        return journal.commit(lsn);
+    }
+
+    bool dropStudent(const string& courseCode, const string& studentID) {
+        string record = Journal::enrollmentRecord(JournalOp::Drop, courseCode, studentID);
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            if (!enrollment.dropStudent(courseCode, studentID)) return false;
+            lsn = journal.append(record);
+        }
+        return journal.commit(lsn);
+    }
+};
+
+// ===================== People Search Index =====================
+
+// Trigram inverted index over each person's name, contact and ID. Fields are
+// lowercased and padded with start/end markers, so short IDs and two-letter
+// prefixes still produce trigrams. Posting lists hold handles in ascending
+// order; persons register as observers, so setName/setContact/setID and
+// destruction update the index incrementally.
+class PersonSearchIndex : public PersonObserver {
+public:
+    struct Hit {
+        const Person* person;
+        double score; // > 1 for substring matches, matched-trigram ratio for fuzzy ones
+    };
+
+    struct Options {
+        size_t limit = 10;
+        int maxTypos = 1;
+        size_t maxCandidates = 4096; // typo-tolerant candidates checked
+    };
+
+private:
+    enum { FieldCount = 3 };
+    static const char Start = '\x02';
+    static const char End = '\x03';
+
+    struct Entry {
+        Person* person = nullptr;
+        string fields[FieldCount]; // lowercased name, contact, ID
+    };
+
+    typedef vector<uint32_t> Postings;
+
+    vector<Entry> entries;
+    unordered_map<const Person*, uint32_t> handles;
+    unordered_map<uint32_t, Postings> postings;
+
+    static uint32_t pack(char a, char b, char c) {
+        return static_cast<uint32_t>(static_cast<unsigned char>(a)) << 16 |
+               static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8 |
+               static_cast<uint32_t>(static_cast<unsigned char>(c));
+    }
+
+    static string lowered(const string& text) {
+        string out(text);
+        for (char& c : out) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return out;
+    }
+
+    static vector<uint32_t> trigramsOf(const Entry& entry) {
+        vector<uint32_t> grams;
+        for (const string& field : entry.fields) {
+            string padded = Start + field + End;
+            for (size_t i = 0; i + 2 < padded.size(); ++i) grams.push_back(pack(padded[i], padded[i + 1], padded[i + 2]));
+        }
+        sort(grams.begin(), grams.end());
+        grams.erase(unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+    // Query trigrams are taken from the bare text so they match anywhere in a
+    // field; a two-letter query becomes a prefix probe.
+    static vector<uint32_t> queryTrigrams(const string& query) {
+        vector<uint32_t> grams;
+        if (query.size() == 2) grams.push_back(pack(Start, query[0], query[1]));
+        for (size_t i = 0; i + 2 < query.size(); ++i) grams.push_back(pack(query[i], query[i + 1], query[i + 2]));
+        sort(grams.begin(), grams.end());
+        grams.erase(unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+    void link(uint32_t handle, const vector<uint32_t>& grams) {
+        for (uint32_t gram : grams) {
+            Postings& list = postings[gram];
+            if (list.empty() || list.back() < handle) list.push_back(handle);
+            else list.insert(lower_bound(list.begin(), list.end(), handle), handle);
+        }
+    }
+
+    void unlink(uint32_t handle, const vector<uint32_t>& grams) {
+        for (uint32_t gram : grams) {
+            auto found = postings.find(gram);
+            if (found == postings.end()) continue;
+            Postings& list = found->second;
+            auto it = lower_bound(list.begin(), list.end(), handle);
+            if (it != list.end() && *it == handle) list.erase(it);
+            if (list.empty()) postings.erase(found);
+        }
+    }
+
+    void load(Entry& entry) {
+        entry.fields[0] = lowered(entry.person->getName());
+        entry.fields[1] = lowered(entry.person->getContact());
+        entry.fields[2] = lowered(entry.person->getID());
+    }
+
+    const Postings* postingsFor(uint32_t gram) const {
+        auto it = postings.find(gram);
+        return it != postings.end() ? &it->second : nullptr;
+    }
+
+    // First position >= handle at or after a cursor, probing 1, 2, 4, ... ahead
+    // before bisecting, so a sweep with ascending handles stays cheap.
+    static Postings::const_iterator gallop(Postings::const_iterator from, Postings::const_iterator end, uint32_t handle) {
+        if (from == end || *from >= handle) return from;
+        ptrdiff_t step = 1;
+        while (end - from > step && *(from + step) < handle) {
+            from += step;
+            step *= 2;
+        }
+        return lower_bound(from + 1, end - from > step ? from + step + 1 : end, handle);
+    }
+
+    static constexpr double ExactScore = 4.0;
+
+    // Exact field > field prefix > substring anywhere; 0 if no field contains the query.
+    static double substringScore(const Entry& entry, const string& query) {
+        double best = 0.0;
+        for (const string& field : entry.fields) {
+            size_t at = field.find(query);
+            if (at == string::npos) continue;
+            double score = field.size() == query.size() ? ExactScore : at == 0 ? 3.0 : 2.0;
+            best = max(best, score);
+        }
+        return best;
+    }
+
+public:
+    PersonSearchIndex() {}
+    PersonSearchIndex(const PersonSearchIndex&) = delete;
+    PersonSearchIndex& operator=(const PersonSearchIndex&) = delete;
+
+    ~PersonSearchIndex() override {
+        for (Entry& entry : entries)
+            if (entry.person) entry.person->removeObserver(this);
+    }
+
+    // Indexes a person and starts tracking its edits; re-adding refreshes it.
+    void add(Person* person) {
+        auto it = handles.find(person);
+        if (it != handles.end()) {
+            personChanged(person);
+            return;
+        }
+        uint32_t handle = static_cast<uint32_t>(entries.size());
+        entries.emplace_back();
+        Entry& entry = entries.back();
+        entry.person = person;
+        load(entry);
+        link(handle, trigramsOf(entry));
+        handles.emplace(person, handle);
+        person->addObserver(this);
+    }
+
+    void remove(Person* person) {
+        auto it = handles.find(person);
+        if (it == handles.end()) return;
+        Entry& entry = entries[it->second];
+        unlink(it->second, trigramsOf(entry));
+        person->removeObserver(this);
+        entry = Entry();
+        handles.erase(it);
+    }
+
+    // Relinks only the trigrams that actually changed.
+    void personChanged(Person* person) override {
+        auto it = handles.find(person);
+        if (it == handles.end()) return;
+        uint32_t handle = it->second;
+        Entry& entry = entries[handle];
+        vector<uint32_t> before = trigramsOf(entry);
+        load(entry);
+        vector<uint32_t> after = trigramsOf(entry);
+
+        vector<uint32_t> gone, added;
+        set_difference(before.begin(), before.end(), after.begin(), after.end(), back_inserter(gone));
+        set_difference(after.begin(), after.end(), before.begin(), before.end(), back_inserter(added));
+        unlink(handle, gone);
+        link(handle, added);
+    }
+
+    void personDestroyed(Person* person) override { remove(person); }
+
+    size_t size() const { return handles.size(); }
+
+    // Substring matches are found by intersecting every query trigram's list,
+    // driving from the shortest, and verified against the stored fields. When
+    // nothing matches exactly, typo-tolerant matching ranks people sharing at
+    // least n - 4 * maxTypos of the n query trigrams (a substitution destroys
+    // at most three, an adjacent transposition four). By pigeonhole such a
+    // person appears in at least two of the 4 * maxTypos + 2 shortest lists,
+    // so only those are merged for candidates; if there are too many, the
+    // ones found in the most of those lists are kept. Substring matches are
+    // ranked in a bounded heap as they are verified. A field prefix needs the
+    // padded start trigram to exist and an exact field also the end one, so
+    // those bound the best possible score; the sweep stops once the heap holds
+    // `limit` hits at that bound, which nothing later can beat.
+    vector<Hit> search(const string& text, const Options& options) const {
+        vector<Hit> hits;
+        if (options.limit == 0) return hits;
+        string query = lowered(text);
+        vector<uint32_t> grams = queryTrigrams(query);
+        if (grams.empty()) return hits;
+
+        vector<const Postings*> lists;
+        for (uint32_t gram : grams)
+            if (const Postings* list = postingsFor(gram)) lists.push_back(list);
+        sort(lists.begin(), lists.end(), [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+        size_t missing = grams.size() - lists.size();
+        vector<Postings::const_iterator> cursors;
+        for (const Postings* list : lists) cursors.push_back(list->begin());
+
+        if (missing == 0) {
+            // Min-heap of the best (score, handle) so far; earlier handles win ties.
+            typedef pair<double, uint32_t> Ranked;
+            auto better = [](const Ranked& a, const Ranked& b) {
+                return a.first != b.first ? a.first > b.first : a.second < b.second;
+            };
+            double ceiling = 2.0;
+            if (query.size() >= 2 && postingsFor(pack(Start, query[0], query[1]))) {
+                ceiling = 3.0;
+                if (postingsFor(pack(query[query.size() - 2], query.back(), End))) ceiling = ExactScore;
+            }
+            vector<Ranked> best;
+            for (uint32_t handle : *lists[0]) {
+                if (best.size() == options.limit && best.front().first >= ceiling) break;
+                bool inAll = true;
+                for (size_t i = 1; i < lists.size() && inAll; ++i) {
+                    cursors[i] = gallop(cursors[i], lists[i]->end(), handle);
+                    inAll = cursors[i] != lists[i]->end() && *cursors[i] == handle;
+                }
+                if (!inAll) continue;
+                double score = substringScore(entries[handle], query);
+                if (score <= 0.0) continue;
+                Ranked ranked(score, handle);
+                if (best.size() < options.limit) {
+                    best.push_back(ranked);
+                    push_heap(best.begin(), best.end(), better);
+                } else if (better(ranked, best.front())) {
+                    pop_heap(best.begin(), best.end(), better);
+                    best.back() = ranked;
+                    push_heap(best.begin(), best.end(), better);
+                }
+            }
+            sort(best.begin(), best.end(), better);
+            for (const Ranked& ranked : best) hits.push_back(Hit{entries[ranked.second].person, ranked.first});
+        }
+
+        size_t n = grams.size();
+        size_t slack = static_cast<size_t>(max(0, options.maxTypos)) * 4;
+        if (hits.empty() && n > slack && missing <= slack) {
+            size_t allowedMisses = slack - missing;
+            size_t probe = min(lists.size(), allowedMisses + 2);
+            size_t need = probe > allowedMisses ? probe - allowedMisses : 1;
+            vector<pair<uint32_t, uint32_t>> candidates; // handle, probed lists containing it
+            for (size_t i = 0; i < probe; ++i) cursors[i] = lists[i]->begin();
+            while (true) {
+                uint32_t low = UINT32_MAX;
+                for (size_t i = 0; i < probe; ++i)
+                    if (cursors[i] != lists[i]->end()) low = min(low, *cursors[i]);
+                if (low == UINT32_MAX) break;
+                uint32_t shared = 0;
+                for (size_t i = 0; i < probe; ++i)
+                    if (cursors[i] != lists[i]->end() && *cursors[i] == low) {
+                        ++shared;
+                        ++cursors[i];
+                    }
+                if (shared >= need) candidates.emplace_back(low, shared);
+            }
+            if (candidates.size() > options.maxCandidates) {
+                auto byShared = [](const pair<uint32_t, uint32_t>& a, const pair<uint32_t, uint32_t>& b) {
+                    return a.second != b.second ? a.second > b.second : a.first < b.first;
+                };
+                nth_element(candidates.begin(), candidates.begin() + options.maxCandidates, candidates.end(), byShared);
+                candidates.resize(options.maxCandidates);
+                sort(candidates.begin(), candidates.end()); // back to handle order for the galloping cursors
+            }
+
+            for (size_t i = 0; i < lists.size(); ++i) cursors[i] = lists[i]->begin();
+            for (const auto& candidate : candidates) {
+                uint32_t handle = candidate.first;
+                size_t misses = 0;
+                for (size_t i = 0; i < lists.size() && misses <= allowedMisses; ++i) {
+                    cursors[i] = gallop(cursors[i], lists[i]->end(), handle);
+                    if (cursors[i] == lists[i]->end() || *cursors[i] != handle) ++misses;
+                }
+                if (misses <= allowedMisses)
+                    hits.push_back(Hit{entries[handle].person, static_cast<double>(lists.size() - misses) / n});
+            }
+        }
+
+        stable_sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) { return a.score > b.score; });
+        hits.resize(min(options.limit, hits.size()));
+        return hits;
+    }
+
+    vector<Hit> search(const string& text) const { return search(text, Options()); }
+};
+
 // ===================== Test Program =====================
 
 void testPolymorphism(Person* p) {
@@ -213,7 +1683,266 @@ void testPolymorphism(Person* p) {
     cout << "Payment: $" << p->calculatePayment() << endl;
 }
 
-int main() {
+// Builds a 1M-person index, then times substring, prefix and misspelled lookups.
+void benchmarkPeopleSearch(size_t peopleCount, size_t queryCount) {
+    const vector<string> first = { "alice", "bob", "carol", "david", "erin", "farah", "gustavo", "hana", "ivan", "julia",
+                                   "kenji", "laila", "mateo", "nora", "omar", "priya", "quinn", "rosa", "sven", "tariq" };
+    const vector<string> last = { "smith", "johnson", "nguyen", "garcia", "okafor", "kowalski", "tanaka", "haddad",
+                                  "fernandez", "lindqvist", "moreau", "petrov", "rahman", "schmidt", "silva", "walker" };
+    vector<Student> people;
+    people.reserve(peopleCount);
+    for (size_t i = 0; i < peopleCount; ++i) {
+        const string& f = first[i % first.size()];
+        const string& l = last[(i / first.size()) % last.size()];
+        string id = "S" + to_string(1000000 + i);
+        string name = f;
+        name[0] = static_cast<char>(toupper(name[0]));
+        people.emplace_back(name + " " + l + to_string(i / 320), 20, id, f + "." + l + to_string(i) + "@mail.com", "2022-09-01", "CS", 3.0);
+    }
+
+    PersonSearchIndex index;
+    auto start = chrono::steady_clock::now();
+    for (Student& person : people) index.add(&person);
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    uint64_t state = 88172645463325252ull;
+    auto next = [&state]() { state ^= state << 13; state ^= state >> 7; state ^= state << 17; return state; };
+    vector<double> latencies;
+    size_t found = 0;
+    for (size_t q = 0; q < queryCount; ++q) {
+        const Student& target = people[next() % peopleCount];
+        string query;
+        switch (q % 4) {
+            case 0: query = target.getName().substr(0, target.getName().find(' ') + 5); break; // "Alice smit"
+            case 1: query = target.getContact().substr(0, target.getContact().find('@')); break;
+            case 2: query = target.getID(); break;
+            default: {
+                query = target.getContact().substr(0, target.getContact().find('@'));
+                swap(query[1], query[2]); // transposition typo
+            }
+        }
+        auto t0 = chrono::steady_clock::now();
+        found += index.search(query).size();
+        latencies.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+    }
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < 10000; ++i) people[next() % peopleCount].setContact("moved" + to_string(i) + "@example.org");
+    double updateSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    sort(latencies.begin(), latencies.end());
+    cout << "search people=" << peopleCount << " build=" << buildSeconds << "s"
+         << " p50=" << latencies[latencies.size() / 2] << "us"
+         << " p99=" << latencies[latencies.size() * 99 / 100] << "us"
+         << " max=" << latencies.back() << "us"
+         << " hits=" << found << " update=" << updateSeconds * 1e6 / 10000 << "us" << endl;
+}
+
+// Group-commit throughput: explicit batches from one writer, then many
+// concurrent writers sharing syncs, then replay speed of a large journal.
+void benchmarkJournal(const string& path) {
+    auto run = [&path](const char* label, size_t batchSize, unsigned threads, size_t perThread) {
+        unlink(path.c_str());
+        GradeBook gradeBook;
+        EnrollmentManager enrollment;
+        Journal journal;
+        if (!journal.open(path)) {
+            cout << journal.error() << endl;
+            return;
+        }
+        DurableRegistrar registrar(gradeBook, enrollment, journal);
+        auto start = chrono::steady_clock::now();
+        vector<thread> writers;
+        for (unsigned t = 0; t < threads; ++t) {
+            writers.emplace_back([&registrar, t, batchSize, perThread]() {
+                vector<pair<string, double>> batch;
+                for (size_t i = 0; i < perThread; ++i) {
+                    string id = "S" + to_string(t * 10000000 + i);
+                    if (batchSize <= 1) {
+                        registrar.setGrade(id, static_cast<double>(i % 101));
+                        continue;
+                    }
+                    batch.emplace_back(id, static_cast<double>(i % 101));
+                    if (batch.size() == batchSize) {
+                        registrar.setGrades(batch);
+                        batch.clear();
+                    }
+                }
+                registrar.setGrades(batch);
+            });
+        }
+        for (auto& w : writers) w.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double records = static_cast<double>(threads) * perThread;
+        cout << "journal " << label << " records=" << records << " records/s=" << records / seconds
+             << " syncs=" << journal.getSyncCount() << " records/sync=" << records / max<uint64_t>(1, journal.getSyncCount())
+             << endl;
+    };
+
+    run("batch=1", 1, 1, 2000);
+    run("batch=16", 16, 1, 16000);
+    run("batch=256", 256, 1, 128000);
+    run("batch=4096", 4096, 1, 1000000);
+    run("threads=8", 1, 8, 1000);
+    run("threads=64", 1, 64, 250);
+    run("threads=256", 1, 256, 100);
+
+    // The batch=4096 journal is gone; write 1M records in large batches and replay them.
+    run("replay-input", 4096, 1, 1000000);
+    GradeBook gradeBook;
+    EnrollmentManager enrollment;
+    auto start = chrono::steady_clock::now();
+    ReplayStats stats = Journal::replay(path, gradeBook, enrollment);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "journal replay records=" << stats.records << " MiB=" << stats.bytes / (1024.0 * 1024.0)
+         << " ms=" << seconds * 1e3 << " records/s=" << stats.records / seconds << endl;
+    unlink(path.c_str());
+}
+
+// Crash-recovery harness. Each round recovers the journal, forks a child that
+// keeps writing grades and enrollments from several threads while publishing
+// what has been acknowledged, kills it with SIGKILL at a random moment, and
+// appends half a record to mimic a torn write. The next recovery must drop the
+// torn tail and still contain everything the child had acknowledged.
+bool journalCrashTest(const string& path, int rounds) {
+    const unsigned writers = 8;
+    unlink(path.c_str());
+    auto* acked = static_cast<atomic<uint64_t>*>(mmap(nullptr, sizeof(atomic<uint64_t>) * writers, PROT_READ | PROT_WRITE,
+                                                      MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    if (acked == MAP_FAILED) return false;
+    bool passed = true;
+    uint32_t seed = 2463534242u;
+
+    for (int round = 0; round < rounds && passed; ++round) {
+        for (unsigned t = 0; t < writers; ++t) acked[t].store(0);
+
+        pid_t child = fork();
+        if (child == 0) {
+            GradeBook gradeBook;
+            EnrollmentManager enrollment;
+            Journal::replay(path, gradeBook, enrollment);
+            Journal journal;
+            if (!journal.open(path)) _exit(1);
+            DurableRegistrar registrar(gradeBook, enrollment, journal);
+            vector<uint64_t> resumeFrom(writers); // read before any writer touches gradeBook
+            for (unsigned t = 0; t < writers; ++t)
+                resumeFrom[t] = static_cast<uint64_t>(max(0.0, gradeBook.getGrade("T" + to_string(t)))) + 1;
+            vector<thread> threads;
+            for (unsigned t = 0; t < writers; ++t) {
+                threads.emplace_back([&, t]() {
+                    string id = "T" + to_string(t), course = "C" + to_string(t);
+                    for (uint64_t n = resumeFrom[t];; ++n) {
+                        if (!registrar.setGrade(id, static_cast<double>(n))) _exit(1);
+                        if (!registrar.enrollStudent(course, id + "-" + to_string(n))) _exit(1);
+                        acked[t].store(n);
+                    }
+                });
+            }
+            for (auto& th : threads) th.join();
+            _exit(0);
+        }
+
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        this_thread::sleep_for(chrono::milliseconds(50 + seed % 150));
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+        string torn = Journal::gradeRecord("T0", 1e9);
+        if (fd >= 0) {
+            ssize_t ignored = ::write(fd, torn.data(), torn.size() / 2);
+            (void)ignored;
+            ::close(fd);
+        }
+
+        GradeBook gradeBook;
+        EnrollmentManager enrollment;
+        ReplayStats stats = Journal::replay(path, gradeBook, enrollment);
+        // The kill may also land mid-write, leaving a partial record of the
+        // child's in front of ours; both are discarded.
+        bool roundOk = stats.discardedBytes >= torn.size() / 2;
+        for (unsigned t = 0; t < writers; ++t) {
+            string id = "T" + to_string(t);
+            uint64_t ack = acked[t].load();
+            if (gradeBook.getGrade(id) < static_cast<double>(ack)) roundOk = false;
+            if (ack && !enrollment.isEnrolled("C" + to_string(t), id + "-" + to_string(ack))) roundOk = false;
+        }
+        cout << "crash round " << round << ": replayed " << stats.records << " records, discarded "
+             << stats.discardedBytes << " torn bytes, " << (roundOk ? "ok" : "FAILED") << endl;
+        passed = passed && roundOk;
+    }
+
+    munmap(acked, sizeof(atomic<uint64_t>) * writers);
+    unlink(path.c_str());
+    return passed;
+}
+
+// Writer throughput and latency with no reader, with a reader scanning
+// snapshots back to back, and with a reader that locks the GradeBook for
+// each scan instead.
+void benchmarkSnapshots(size_t studentCount, size_t writes) {
+    const char* modes[] = { "idle", "cow", "locked-scan" };
+    for (int mode = 0; mode < 3; ++mode) {
+        bool useSnapshots = mode != 2;
+        GradeBook gradeBook;
+        for (size_t i = 0; i < studentCount; ++i) gradeBook.addGrade("S" + to_string(i), static_cast<double>(i % 101));
+
+        mutex scanLock;
+        atomic<bool> done{false};
+        size_t scans = 0, inconsistent = 0;
+        thread reader([&]() {
+            while (mode != 0 && !done.load(memory_order_relaxed)) {
+                unique_lock<mutex> guard(scanLock, defer_lock);
+                if (!useSnapshots) guard.lock();
+                GradeSnapshot snap = gradeBook.snapshot();
+                double sum = 0.0;
+                snap.forEach(0, snap.size(), [&sum](const GradeIndex::Entry& entry) { sum += entry.grade; });
+                if (fabs(sum - snap.getSummary().sum) > 1e-6 * max(1.0, sum)) ++inconsistent;
+                ++scans;
+            }
+        });
+
+        vector<double> latencies;
+        latencies.reserve(writes);
+        uint64_t state = 88172645463325252ull;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < writes; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            string id = "S" + to_string(state % studentCount);
+            auto t0 = chrono::steady_clock::now();
+            {
+                unique_lock<mutex> guard(scanLock, defer_lock);
+                if (!useSnapshots) guard.lock();
+                gradeBook.addGrade(id, static_cast<double>(state % 101));
+            }
+            latencies.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        done = true;
+        reader.join();
+
+        sort(latencies.begin(), latencies.end());
+        cout << "snapshot " << modes[mode] << " students=" << studentCount
+             << " writes/s=" << writes / seconds << " p99=" << latencies[writes * 99 / 100] << "us"
+             << " p99.9=" << latencies[writes * 999 / 1000] << "us max=" << latencies.back() << "us"
+             << " scans=" << scans << " inconsistent=" << inconsistent << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchmarkPeopleSearch(1000000, 20000);
+        benchmarkJournal("bench_journal.log");
+        benchmarkSnapshots(200000, 1000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--crash-test")
+        return journalCrashTest("crash_journal.log", 5) ? 0 : 1;
+
     // Test Object Creation
     Student s1("Alice", 20, "S1001", "alice@mail.com", "2022-09-01", "Computer Science", 3.5);
     Student s2("Bob", 22, "S1002", "bob@mail.com", "2021-09-01", "Mathematics", 2.8);
@@ -230,18 +1959,94 @@ int main() {
     gb.addGrade("S1002", 45);
     cout << "\nAverage Grade: " << gb.calculateAverageGrade() << endl;
     cout << "Highest Grade: " << gb.getHighestGrade() << endl;
+    gb.addGrade("S1002", 55);
+    cout << "Average after regrade: " << gb.calculateAverageGrade()
+         << ", Variance: " << gb.getGradeVariance() << endl;
+
+    CourseGradeStats courseStats;
+    courseStats.addGrade("CS101", "S1001", 85);
+    courseStats.addGrade("CS101", "S1002", 72);
+    CourseGradeStats::Reader cs101 = courseStats.reader("CS101");
+    GradeSummary cs101Summary = cs101.summary();
+    cout << "CS101 Average: " << cs101Summary.average() << ", Lowest: " << cs101Summary.lowest
+         << ", Highest: " << cs101Summary.highest << endl;
 
-    auto failing = gb.getFailingStudents();
-    for (auto& id : failing)
-        cout << "Failing: " << id << endl;
+    gb.addGrade("S1003", 38);
+    gb.addGrade("S1004", 91);
+    for (const auto& entry : gb.failingStudents())
+        cout << "Failing: " << entry.studentID << endl;
+    cout << "Median: " << gb.getMedianGrade() << ", P90: " << gb.getPercentile(90)
+         << ", Rank of S1001: " << gb.getClassRank("S1001") << endl;
+    for (const auto& entry : gb.getTopStudents(2))
+        cout << "Top: " << entry.studentID << " (" << entry.grade << ")" << endl;
 
     // EnrollmentManager Test
     EnrollmentManager em;
     em.enrollStudent("CS101", "S1001");
     em.enrollStudent("CS101", "S1002");
+    em.enrollStudent("CS101", "S1002");
     cout << "Enrollment in CS101: " << em.getEnrollmentCount("CS101") << endl;
     em.dropStudent("CS101", "S1002");
     cout << "Enrollment in CS101 after drop: " << em.getEnrollmentCount("CS101") << endl;
+    em.dropStudent("PHYS999", "S1001");
+    size_t added = em.enrollStudents({ {"MATH202", "S1001"}, {"MATH202", "S1002"}, {"MATH202", "S1001"} });
+    cout << "Bulk enrolled in MATH202: " << added << ", unknown course count: "
+         << em.getEnrollmentCount("PHYS999") << endl;
+    for (const auto& code : em.getStudentCourses("S1001"))
+        cout << "S1001 takes: " << code << endl;
+    for (const auto& id : em.getSharedStudents("CS101", "MATH202"))
+        cout << "Shared by CS101 and MATH202: " << id << endl;
+
+    // PersonSearchIndex Test
+    PersonSearchIndex search;
+    for (Person* p : vector<Person*>{ &s1, &s2, &p1, &p2 }) search.add(p);
+    for (const string query : { "smi", "bob@", "Dr. Smiht" })
+        for (const auto& hit : search.search(query))
+            cout << "Search '" << query << "': " << hit.person->getName() << " (" << hit.score << ")" << endl;
+    s1.setContact("alice.w@uni.edu");
+    cout << "Matches for 'uni.edu' after edit: " << search.search("uni.edu").size()
+         << ", for 'alice@mail': " << search.search("alice@mail").size() << endl;
+
+    // Snapshot Test: the views keep their point-in-time state while writes continue
+    GradeSnapshot gradesBefore = gb.snapshot();
+    EnrollmentSnapshot enrollmentBefore = em.snapshot();
+    gb.addGrade("S1002", 100);
+    em.dropStudent("MATH202", "S1001");
+    cout << "Snapshot average: " << gradesBefore.calculateAverageGrade() << " (live " << gb.calculateAverageGrade()
+         << "), failing in snapshot: " << gradesBefore.getFailingStudents().size()
+         << ", MATH202 in snapshot: " << enrollmentBefore.getEnrollmentCount("MATH202")
+         << " (live " << em.getEnrollmentCount("MATH202") << ")" << endl;
+
+    // DurableRegistrar Test: state survives a restart through the journal
+    char journalPath[] = "/tmp/registrar-XXXXXX";
+    int journalFd = mkstemp(journalPath);
+    if (journalFd >= 0) {
+        close(journalFd);
+        uint64_t syncs = 0;
+        {
+            GradeBook durableGrades;
+            EnrollmentManager durableEnrollment;
+            Journal journal;
+            if (journal.open(journalPath)) {
+                DurableRegistrar registrar(durableGrades, durableEnrollment, journal);
+                registrar.setGrade("S1001", 70);
+                registrar.setGrade("S1001", 71);
+                registrar.enrollStudent("CS101", "S1001");
+                registrar.enrollStudent("MATH202", "S1001");
+                registrar.dropStudent("MATH202", "S1001");
+                syncs = journal.getSyncCount();
+            } else {
+                cout << journal.error() << endl;
+            }
+        }
+        GradeBook recoveredGrades;
+        EnrollmentManager recoveredEnrollment;
+        ReplayStats replayed = Journal::replay(journalPath, recoveredGrades, recoveredEnrollment);
+        cout << "Journal replayed " << replayed.records << " records (" << syncs << " syncs), S1001 grade "
+             << recoveredGrades.getGrade("S1001") << ", in CS101: " << (recoveredEnrollment.isEnrolled("CS101", "S1001") ? "yes" : "no")
+             << ", in MATH202: " << (recoveredEnrollment.isEnrolled("MATH202", "S1001") ? "yes" : "no") << endl;
+        unlink(journalPath);
+    }
 
     // Polymorphism Test
     vector<Person*> people = { &s1, &s2, &p1, &p2 };
@@ -4,21 +4,172 @@
 #include <map>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <thread>
+#include <chrono>
+#include <tuple>
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <type_traits>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <bitset>
+#include <random>
+#include <fstream>
+#include <charconv>
+#include <cerrno>
+#include <limits>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
+// Build with -DCOUNT_ALLOCATIONS to have the benchmarks report heap allocation counts.
+#ifdef COUNT_ALLOCATIONS
+atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#endif
+
+size_t allocationsSoFar() {
+#ifdef COUNT_ALLOCATIONS
+    return allocationCount.load(memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+// ===================== Symbol Table =====================
+
+typedef uint32_t Symbol;
+
+// Process-wide string interning for IDs, programs, departments and dates.
+// Keys live in the map's nodes, which never move, so str() references stay
+// valid. Not safe for concurrent intern() calls.
+class SymbolTable {
+private:
+    unordered_map<string, Symbol> symbols;
+    vector<const string*> strings;
+
+public:
+    static const Symbol npos = UINT32_MAX;
+
+    Symbol intern(const string& key) {
+        auto it = symbols.find(key);
+        if (it != symbols.end()) return it->second;
+        Symbol symbol = static_cast<Symbol>(strings.size());
+        auto inserted = symbols.emplace(key, symbol).first;
+        strings.push_back(&inserted->first);
+        return symbol;
+    }
+
+    Symbol find(const string& key) const {
+        auto it = symbols.find(key);
+        return it != symbols.end() ? it->second : npos;
+    }
+
+    const string& str(Symbol symbol) const { return *strings[symbol]; }
+    size_t size() const { return strings.size(); }
+
+    // Rough heap footprint: map nodes, bucket array, reverse table and long-string buffers.
+    size_t bytesUsed() const {
+        size_t bytes = symbols.bucket_count() * sizeof(void*) + strings.capacity() * sizeof(const string*);
+        for (const auto& entry : symbols) {
+            bytes += sizeof(entry) + 2 * sizeof(void*);
+            if (entry.first.capacity() > 15) bytes += entry.first.capacity() + 1;
+        }
+        return bytes;
+    }
+};
+
+SymbolTable& symbols() {
+    static SymbolTable table;
+    return table;
+}
+
+Symbol intern(const string& key) { return symbols().intern(key); }
+const string& str(Symbol symbol) { return symbols().str(symbol); }
+
+// ===================== Cold Store =====================
+
+// Descriptive strings that hot loops never read (names, contacts, thesis and
+// course text) are moved out of the objects into a separately allocated
+// record. Objects hold one pointer in their place, so scans over IDs, GPA or
+// credits stream through compact objects and the record is only touched by
+// getters, displayDetails() and writers. The record belongs to its object:
+// copies clone it, destruction (including UniversityRegistry::clear()) frees
+// it, and a moved-from object holds none (copying one copies that null).
+template <typename T>
+class ColdRef {
+private:
+    unique_ptr<const T> record;
+
+public:
+    explicit ColdRef(T value) : record(new T(move(value))) {}
+    ColdRef(const ColdRef& other) : record(other.record ? new T(*other.record) : nullptr) {}
+    ColdRef(ColdRef&&) noexcept = default;
+
+    ColdRef& operator=(const ColdRef& other) {
+        record.reset(other.record ? new T(*other.record) : nullptr);
+        return *this;
+    }
+    ColdRef& operator=(ColdRef&&) noexcept = default;
+
+    const T& operator*() const { return *record; }
+    const T* operator->() const { return record.get(); }
+};
+
+struct PersonDetails {
+    string name, contact;
+};
+
+struct ThesisDetails {
+    string researchTopic, thesisTitle;
+};
+
+struct CourseDetails {
+    string title, description;
+};
+
 class Person {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 protected:
-    string name;
     int age;
-    string ID;
-    string contact;
+    Symbol ID;
+    ColdRef<PersonDetails> details; // name, contact
 
 public:
-    Person(string name, int age, string ID, string contact)
-        : name(name), age(age), ID(ID), contact(contact) {}
+    Person(const string& name, int age, const string& ID, const string& contact)
+        : age(age), ID(intern(ID)), details(PersonDetails{name, contact}) {}
+
+    Person(const Person&) = default;
+    Person& operator=(const Person&) = default;
+    // UniversityRegistry pools insert by move; a class with a user-declared
+    // destructor gets no implicit move members.
+    Person(Person&&) = default;
+    Person& operator=(Person&&) = default;
+
+    const string& getID() const { return str(ID); }
+    Symbol getIDSymbol() const { return ID; }
+    const string& getName() const { return details->name; }
+    const string& getContact() const { return details->contact; }
 
     virtual void displayDetails() const {
-        cout << "Name: " << name << ", Age: " << age << ", ID: " << ID << ", Contact: " << contact << endl;
+        cout << "Name: " << details->name << ", Age: " << age << ", ID: " << str(ID) << ", Contact: " << details->contact << '\n';
     }
 
     virtual double calculatePayment() const = 0;
@@ -27,18 +178,26 @@ public:
 };
 
 class Student : public Person {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 protected:
-    string enrollmentDate, program;
+    Symbol enrollmentDate, program;
     double GPA;
 
 public:
-    Student(string name, int age, string ID, string contact,
-            string enrollmentDate, string program, double GPA)
-        : Person(name, age, ID, contact), enrollmentDate(enrollmentDate), program(program), GPA(GPA) {}
+    Student(const string& name, int age, const string& ID, const string& contact,
+            const string& enrollmentDate, const string& program, double GPA)
+        : Person(name, age, ID, contact), enrollmentDate(intern(enrollmentDate)), program(intern(program)), GPA(GPA) {}
+
+    const string& getProgram() const { return str(program); }
+    Symbol getProgramSymbol() const { return program; }
+    const string& getEnrollmentDate() const { return str(enrollmentDate); }
+    double getGPA() const { return GPA; }
 
     void displayDetails() const override {
         Person::displayDetails();
-        cout << "Program: " << program << ", GPA: " << GPA << endl;
+        cout << "Program: " << str(program) << ", GPA: " << GPA << '\n';
     }
 
     double calculatePayment() const override {
@@ -47,19 +206,22 @@ public:
 };
 
 class UndergraduateStudent : public Student {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 private:
-    string major, minor, expectedGraduation;
+    Symbol major, minor, expectedGraduation;
 
 public:
-    UndergraduateStudent(string name, int age, string ID, string contact,
-                         string enrollmentDate, string program, double GPA,
-                         string major, string minor, string gradDate)
+    UndergraduateStudent(const string& name, int age, const string& ID, const string& contact,
+                         const string& enrollmentDate, const string& program, double GPA,
+                         const string& major, const string& minor, const string& gradDate)
         : Student(name, age, ID, contact, enrollmentDate, program, GPA),
-          major(major), minor(minor), expectedGraduation(gradDate) {}
+          major(intern(major)), minor(intern(minor)), expectedGraduation(intern(gradDate)) {}
 
     void displayDetails() const override {
         Student::displayDetails();
-        cout << "Major: " << major << ", Minor: " << minor << ", Grad Date: " << expectedGraduation << endl;
+        cout << "Major: " << str(major) << ", Minor: " << str(minor) << ", Grad Date: " << str(expectedGraduation) << '\n';
     }
 
     double calculatePayment() const override {
@@ -68,19 +230,27 @@ public:
 };
 
 class GraduateStudent : public Student {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 private:
-    string researchTopic, advisor, thesisTitle;
+    Symbol advisor;
+    ColdRef<ThesisDetails> thesis; // researchTopic, thesisTitle
 
 public:
-    GraduateStudent(string name, int age, string ID, string contact,
-                    string enrollmentDate, string program, double GPA,
-                    string topic, string advisor, string thesis)
+    GraduateStudent(const string& name, int age, const string& ID, const string& contact,
+                    const string& enrollmentDate, const string& program, double GPA,
+                    const string& topic, const string& advisor, const string& thesis)
         : Student(name, age, ID, contact, enrollmentDate, program, GPA),
-          researchTopic(topic), advisor(advisor), thesisTitle(thesis) {}
+          advisor(intern(advisor)), thesis(ThesisDetails{topic, thesis}) {}
+
+    const string& getResearchTopic() const { return thesis->researchTopic; }
+    const string& getAdvisor() const { return str(advisor); }
+    const string& getThesisTitle() const { return thesis->thesisTitle; }
 
     void displayDetails() const override {
         Student::displayDetails();
-        cout << "Research: " << researchTopic << ", Advisor: " << advisor << ", Thesis: " << thesisTitle << endl;
+        cout << "Research: " << thesis->researchTopic << ", Advisor: " << str(advisor) << ", Thesis: " << thesis->thesisTitle << '\n';
     }
 
     double calculatePayment() const override {
@@ -93,25 +263,34 @@ public:
 };
 
 class Professor : public Person {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 protected:
-    string department, specialization;
-    string hireDate;
+    Symbol department, specialization;
+    Symbol hireDate;
 
 public:
-    Professor(string name, int age, string ID, string contact,
-              string department, string specialization, string hireDate)
-        : Person(name, age, ID, contact), department(department), specialization(specialization), hireDate(hireDate) {}
+    Professor(const string& name, int age, const string& ID, const string& contact,
+              const string& department, const string& specialization, const string& hireDate)
+        : Person(name, age, ID, contact), department(intern(department)), specialization(intern(specialization)),
+          hireDate(intern(hireDate)) {}
+
+    const string& getDepartment() const { return str(department); }
+    Symbol getDepartmentSymbol() const { return department; }
+    Symbol getSpecializationSymbol() const { return specialization; }
 
     void displayDetails() const override {
         Person::displayDetails();
-        cout << "Dept: " << department << ", Specialization: " << specialization << ", Hire Date: " << hireDate << endl;
+        cout << "Dept: " << str(department) << ", Specialization: " << str(specialization)
+             << ", Hire Date: " << str(hireDate) << '\n';
     }
 };
 
 class AssistantProfessor : public Professor {
 public:
-    AssistantProfessor(string name, int age, string ID, string contact,
-                       string department, string specialization, string hireDate)
+    AssistantProfessor(const string& name, int age, const string& ID, const string& contact,
+                       const string& department, const string& specialization, const string& hireDate)
         : Professor(name, age, ID, contact, department, specialization, hireDate) {}
 
     double calculatePayment() const override {
@@ -121,8 +300,8 @@ public:
 
 class AssociateProfessor : public Professor {
 public:
-    AssociateProfessor(string name, int age, string ID, string contact,
-                       string department, string specialization, string hireDate)
+    AssociateProfessor(const string& name, int age, const string& ID, const string& contact,
+                       const string& department, const string& specialization, const string& hireDate)
         : Professor(name, age, ID, contact, department, specialization, hireDate) {}
 
     double calculatePayment() const override {
@@ -132,8 +311,8 @@ public:
 
 class FullProfessor : public Professor {
 public:
-    FullProfessor(string name, int age, string ID, string contact,
-                  string department, string specialization, string hireDate)
+    FullProfessor(const string& name, int age, const string& ID, const string& contact,
+                  const string& department, const string& specialization, const string& hireDate)
         : Professor(name, age, ID, contact, department, specialization, hireDate) {}
 
     double calculatePayment() const override {
@@ -142,31 +321,49 @@ public:
 };
 
 class Course {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 private:
-    string code, title, description;
+    Symbol code;
     int credits;
-    Professor* instructor;
     vector<Student*> students;
+    Professor* instructor;
+    ColdRef<CourseDetails> details; // title, description
 
 public:
-    Course(string code, string title, int credits, string description)
-        : code(code), title(title), credits(credits), description(description), instructor(nullptr) {}
+    Course(const string& code, const string& title, int credits, const string& description)
+        : code(intern(code)), credits(credits), instructor(nullptr), details(CourseDetails{title, description}) {}
+
+    const string& getCode() const { return str(code); }
+    Symbol getCodeSymbol() const { return code; }
+    int getCredits() const { return credits; }
+    const string& getTitle() const { return details->title; }
+    const string& getDescription() const { return details->description; }
 
     void setInstructor(Professor* prof) { instructor = prof; }
     void enrollStudent(Student* student) { students.push_back(student); }
+
+    Professor* getInstructor() const { return instructor; }
+    const vector<Student*>& getStudents() const { return students; }
 };
 
 class Department {
+    friend class SnapshotWriter;
+    friend class ReportWriter;
+
 private:
-    string name;
+    Symbol name;
     vector<Professor*> professors;
     vector<Course> courses;
 
 public:
-    Department(string name) : name(name) {}
+    Department(const string& name) : name(intern(name)) {}
+
+    const string& getName() const { return str(name); }
 
     void addProfessor(Professor* prof) { professors.push_back(prof); }
-    void addCourse(Course course) { courses.push_back(course); }
+    void addCourse(Course course) { courses.push_back(move(course)); }
 
     void listProfessors() const {
         for (auto p : professors) p->displayDetails();
@@ -181,36 +378,53 @@ public:
     void addDepartment(const Department& dept) {
         departments.push_back(dept);
     }
+
+    void addDepartment(Department&& dept) {
+        departments.push_back(move(dept));
+    }
 };
 
 class Classroom {
+    friend class SnapshotWriter;
+
 private:
     string roomNumber;
     int capacity;
 
 public:
-    Classroom(string room, int cap) : roomNumber(room), capacity(cap) {}
+    Classroom(const string& room, int cap) : roomNumber(room), capacity(cap) {}
+
+    const string& getRoomNumber() const { return roomNumber; }
+    int getCapacity() const { return capacity; }
 };
 
 class Schedule {
+    friend class SnapshotWriter;
+
 private:
-    map<string, pair<string, string>> courseSchedule; 
+    unordered_map<Symbol, pair<Symbol, Symbol>> courseSchedule; // course -> (time, room)
 
 public:
-    void addSchedule(string courseCode, string time, string room) {
-        courseSchedule[courseCode] = {time, room};
+    void addSchedule(const string& courseCode, const string& time, const string& room) {
+        courseSchedule[intern(courseCode)] = {intern(time), intern(room)};
     }
 };
 
 class GradeBook {
+    friend class SnapshotWriter;
+
 private:
-    map<string, double> grades; 
+    unordered_map<Symbol, double> grades; // student ID symbol -> grade
 
 public:
-    void addGrade(string studentID, double grade) {
+    void addGrade(Symbol studentID, double grade) {
         grades[studentID] = grade;
     }
 
+    void addGrade(const string& studentID, double grade) {
+        addGrade(intern(studentID), grade);
+    }
+
     double calculateAverageGrade() {
         double sum = 0;
         for (auto& g : grades) sum += g.second;
@@ -219,17 +433,1954 @@ public:
 };
 
 class EnrollmentManager {
+    friend class SnapshotWriter;
+
 private:
-    map<string, vector<string>> courseEnrollments; 
+    unordered_map<Symbol, vector<Symbol>> courseEnrollments; // course symbol -> student ID symbols
 
 public:
-    void enrollStudent(string courseCode, string studentID) {
+    void enrollStudent(Symbol courseCode, Symbol studentID) {
         courseEnrollments[courseCode].push_back(studentID);
     }
+
+    void enrollStudent(const string& courseCode, const string& studentID) {
+        enrollStudent(intern(courseCode), intern(studentID));
+    }
+
+    const vector<Symbol>& getStudents(Symbol courseCode) const {
+        static const vector<Symbol> none;
+        auto it = courseEnrollments.find(courseCode);
+        return it != courseEnrollments.end() ? it->second : none;
+    }
 };
 
+// ===================== Schedule Engine =====================
+
+// The week is a grid of 30-minute slots, Monday 00:00 first.
+const int SlotMinutes = 30;
+const int SlotsPerDay = 24 * 60 / SlotMinutes;
+const int WeeklySlots = 7 * SlotsPerDay;
+
+typedef bitset<WeeklySlots> WeekMask;
+
+struct TimeSlot {
+    uint16_t start, end; // [start, end) in grid slots
+};
+
+WeekMask maskOf(TimeSlot slot) {
+    WeekMask mask;
+    mask.set();
+    mask >>= WeeklySlots - (slot.end - slot.start);
+    return mask << slot.start;
+}
+
+int parseDay(const string& day) {
+    static const char* names[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+    for (int d = 0; d < 7; ++d)
+        if (day == names[d]) return d;
+    return -1;
+}
+
+// "HH:MM" -> minutes since midnight, -1 if malformed or not on a slot boundary.
+int parseClock(const string& text) {
+    int hours, minutes;
+    char colon;
+    if (text.size() != 5 || sscanf(text.c_str(), "%2d%c%2d", &hours, &colon, &minutes) != 3 || colon != ':') return -1;
+    if (hours < 0 || hours > 24 || minutes < 0 || minutes >= 60 || (hours == 24 && minutes)) return -1;
+    int total = hours * 60 + minutes;
+    return total % SlotMinutes ? -1 : total;
+}
+
+// Parses "Mon/Wed 10:00-11:30" (one or more days sharing a time range) or
+// "Tue 10:00" (one slot). Returns false on malformed input.
+bool parseTimeSlots(const string& text, vector<TimeSlot>& out) {
+    size_t space = text.find(' ');
+    if (space == string::npos) return false;
+    string days = text.substr(0, space), times = text.substr(space + 1);
+    size_t dash = times.find('-');
+    int from = parseClock(times.substr(0, dash));
+    int to = dash == string::npos ? from + SlotMinutes : parseClock(times.substr(dash + 1));
+    if (from < 0 || to <= from || to > 24 * 60) return false;
+
+    vector<TimeSlot> parsed;
+    size_t pos = 0;
+    while (pos <= days.size()) {
+        size_t slash = days.find('/', pos);
+        if (slash == string::npos) slash = days.size();
+        int day = parseDay(days.substr(pos, slash - pos));
+        if (day < 0) return false;
+        parsed.push_back(TimeSlot{static_cast<uint16_t>(day * SlotsPerDay + from / SlotMinutes),
+                                  static_cast<uint16_t>(day * SlotsPerDay + to / SlotMinutes)});
+        pos = slash + 1;
+    }
+    out.insert(out.end(), parsed.begin(), parsed.end());
+    return true;
+}
+
+enum class ScheduleConflict { None, RoomBusy, InstructorBusy, UnknownRoom, BadSlot };
+
+// Room and instructor occupancy as weekly bitmaps, so a conflict check is a
+// handful of word ANDs. A transposed slot-major bitmap over rooms, kept in
+// descending capacity order, answers "free rooms at slot with capacity >= N"
+// by masking a prefix of each word.
+class ScheduleEngine {
+private:
+    struct Room {
+        Symbol number;
+        int capacity;
+        WeekMask busy;
+    };
+
+    struct Booking {
+        uint32_t room;
+        Symbol instructor;
+        vector<TimeSlot> slots;
+    };
+
+    vector<Room> rooms;                         // by room id (insertion order)
+    unordered_map<Symbol, uint32_t> roomIds;
+    vector<uint32_t> byCapacity;                // rank -> room id, capacity descending
+    vector<uint32_t> rankOf;                    // room id -> rank
+    vector<vector<uint64_t>> occupiedBySlot;    // [slot][rank / 64]
+    unordered_map<Symbol, WeekMask> instructorBusy;
+    unordered_map<Symbol, vector<Booking>> bookings; // course -> meetings
+
+    void setOccupied(uint32_t room, const WeekMask& mask, bool occupied) {
+        uint32_t rank = rankOf[room];
+        uint64_t bit = uint64_t(1) << (rank % 64);
+        for (int slot = 0; slot < WeeklySlots; ++slot) {
+            if (!mask[slot]) continue;
+            if (occupied) occupiedBySlot[slot][rank / 64] |= bit;
+            else occupiedBySlot[slot][rank / 64] &= ~bit;
+        }
+    }
+
+    // Rooms are added rarely; re-rank and rebuild the transposed bitmap.
+    void rebuildRanks() {
+        byCapacity.resize(rooms.size());
+        for (uint32_t i = 0; i < rooms.size(); ++i) byCapacity[i] = i;
+        stable_sort(byCapacity.begin(), byCapacity.end(),
+                    [this](uint32_t a, uint32_t b) { return rooms[a].capacity > rooms[b].capacity; });
+        rankOf.resize(rooms.size());
+        for (uint32_t r = 0; r < byCapacity.size(); ++r) rankOf[byCapacity[r]] = r;
+        occupiedBySlot.assign(WeeklySlots, vector<uint64_t>((rooms.size() + 63) / 64, 0));
+        for (uint32_t i = 0; i < rooms.size(); ++i) setOccupied(i, rooms[i].busy, true);
+    }
+
+    static WeekMask maskOf(const vector<TimeSlot>& slots) {
+        WeekMask mask;
+        for (TimeSlot slot : slots) mask |= ::maskOf(slot);
+        return mask;
+    }
+
+public:
+    uint32_t addRoom(const Classroom& room) {
+        Symbol number = intern(room.getRoomNumber());
+        auto it = roomIds.find(number);
+        if (it != roomIds.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(rooms.size());
+        rooms.push_back(Room{number, room.getCapacity(), WeekMask()});
+        roomIds.emplace(number, id);
+        rebuildRanks();
+        return id;
+    }
+
+    size_t roomCount() const { return rooms.size(); }
+    const string& roomNumber(uint32_t room) const { return str(rooms[room].number); }
+    int roomCapacity(uint32_t room) const { return rooms[room].capacity; }
+
+    // instructor may be SymbolTable::npos for a section nobody teaches yet;
+    // such bookings only occupy the room.
+    ScheduleConflict checkConflict(uint32_t room, Symbol instructor, const vector<TimeSlot>& slots) const {
+        if (room >= rooms.size()) return ScheduleConflict::UnknownRoom;
+        WeekMask mask = maskOf(slots);
+        if ((rooms[room].busy & mask).any()) return ScheduleConflict::RoomBusy;
+        if (instructor == SymbolTable::npos) return ScheduleConflict::None;
+        auto it = instructorBusy.find(instructor);
+        if (it != instructorBusy.end() && (it->second & mask).any()) return ScheduleConflict::InstructorBusy;
+        return ScheduleConflict::None;
+    }
+
+    // Adds one meeting pattern for the course; a course may be booked several times.
+    ScheduleConflict book(Symbol course, uint32_t room, Symbol instructor, const vector<TimeSlot>& slots) {
+        ScheduleConflict conflict = checkConflict(room, instructor, slots);
+        if (conflict != ScheduleConflict::None) return conflict;
+        WeekMask mask = maskOf(slots);
+        rooms[room].busy |= mask;
+        if (instructor != SymbolTable::npos) instructorBusy[instructor] |= mask;
+        setOccupied(room, mask, true);
+        bookings[course].push_back(Booking{room, instructor, slots});
+        return ScheduleConflict::None;
+    }
+
+    // An empty instructorID books the room only.
+    ScheduleConflict book(const string& courseCode, const string& roomNumber, const string& instructorID, const string& when) {
+        vector<TimeSlot> slots;
+        if (!parseTimeSlots(when, slots)) return ScheduleConflict::BadSlot;
+        auto it = roomIds.find(symbols().find(roomNumber));
+        if (it == roomIds.end()) return ScheduleConflict::UnknownRoom;
+        Symbol instructor = instructorID.empty() ? SymbolTable::npos : intern(instructorID);
+        return book(intern(courseCode), it->second, instructor, slots);
+    }
+
+    // Drops every meeting of the course.
+    void unbook(Symbol course) {
+        auto it = bookings.find(course);
+        if (it == bookings.end()) return;
+        for (const Booking& b : it->second) {
+            WeekMask mask = maskOf(b.slots);
+            rooms[b.room].busy &= ~mask;
+            if (b.instructor != SymbolTable::npos) instructorBusy[b.instructor] &= ~mask;
+            setOccupied(b.room, mask, false);
+        }
+        bookings.erase(it);
+    }
+
+    // Rooms free for the whole of `when` with at least minCapacity seats, largest first.
+    vector<uint32_t> freeRooms(const vector<TimeSlot>& when, int minCapacity) const {
+        // Rooms in rank order with enough seats form a prefix.
+        size_t eligible = lower_bound(byCapacity.begin(), byCapacity.end(), minCapacity,
+                                      [this](uint32_t room, int seats) { return rooms[room].capacity >= seats; })
+                        - byCapacity.begin();
+        size_t words = (eligible + 63) / 64;
+        vector<uint64_t> free(words, ~uint64_t(0));
+        if (eligible % 64) free[words - 1] = (uint64_t(1) << (eligible % 64)) - 1;
+        for (TimeSlot t : when)
+            for (int slot = t.start; slot < t.end; ++slot)
+                for (size_t w = 0; w < words; ++w) free[w] &= ~occupiedBySlot[slot][w];
+
+        vector<uint32_t> result;
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = free[w]; bits; bits &= bits - 1)
+                result.push_back(byCapacity[w * 64 + __builtin_ctzll(bits)]);
+        }
+        return result;
+    }
+
+    vector<uint32_t> freeRooms(const string& when, int minCapacity) const {
+        vector<TimeSlot> slots;
+        if (!parseTimeSlots(when, slots)) return vector<uint32_t>();
+        return freeRooms(slots, minCapacity);
+    }
+};
+
+// ===================== Room Assignment Solver =====================
+
+struct SectionRequest {
+    Symbol course;
+    Symbol instructor;        // SymbolTable::npos if none
+    vector<Symbol> students;  // deduplicated student IDs
+};
+
+struct SolverOptions {
+    chrono::milliseconds budget{1000};
+    unsigned threads = 0; // 0 = hardware_concurrency()
+    uint32_t seed = 1;
+};
+
+// Assigns each section one meeting pattern and one room. Hard constraints:
+// enrollment fits the room, no room or instructor is double-booked. Soft:
+// students shared by sections whose patterns overlap, then wasted seats.
+// Every thread runs randomized greedy construction followed by local search
+// and restarts until the budget runs out; the best solution overall wins.
+class RoomAssignmentSolver {
+public:
+    struct Placement {
+        int pattern = -1;
+        int room = -1;
+    };
+
+    struct Solution {
+        vector<Placement> placements; // by section
+        size_t unassigned = 0;
+        long studentConflicts = 0;
+        long wastedSeats = 0;
+        size_t restarts = 0;
+
+        double cost() const { return unassigned * 1e9 + studentConflicts * 1e3 + wastedSeats; }
+    };
+
+private:
+    struct Room {
+        Symbol number;
+        int capacity;
+    };
+
+    vector<SectionRequest> sections;
+    vector<Room> rooms;                    // capacity ascending
+    vector<string> patternText;
+    vector<vector<TimeSlot>> patternSlots;
+    vector<WeekMask> patternMasks;
+    vector<vector<char>> overlaps;         // [pattern][pattern]
+    vector<int> instructorOf;              // section -> dense instructor index or -1
+    size_t instructorCount = 0;
+    vector<vector<pair<uint32_t, int>>> neighbors; // section -> (other section, shared students)
+
+    struct State {
+        vector<Placement> placements;
+        vector<WeekMask> roomBusy;
+        vector<WeekMask> instructorBusy;
+    };
+
+    long sharedConflicts(const State& state, uint32_t section, int pattern) const {
+        long cost = 0;
+        for (const auto& n : neighbors[section]) {
+            int other = state.placements[n.first].pattern;
+            if (other >= 0 && overlaps[pattern][other]) cost += n.second;
+        }
+        return cost;
+    }
+
+    // Cheapest feasible placement for an unplaced section, scored like Solution::cost().
+    Placement bestPlacement(const State& state, uint32_t section, mt19937& rng, double& bestCost) const {
+        Placement best;
+        bestCost = 1e9;
+        int size = static_cast<int>(sections[section].students.size());
+        uniform_real_distribution<double> jitter(0.0, 0.5);
+        for (int p = 0; p < static_cast<int>(patternMasks.size()); ++p) {
+            const WeekMask& mask = patternMasks[p];
+            int instructor = instructorOf[section];
+            if (instructor >= 0 && (state.instructorBusy[instructor] & mask).any()) continue;
+            // Rooms are sorted by capacity, so the first free one that fits wastes the fewest seats.
+            auto room = lower_bound(rooms.begin(), rooms.end(), size, [](const Room& r, int n) { return r.capacity < n; });
+            for (; room != rooms.end(); ++room)
+                if (!(state.roomBusy[room - rooms.begin()] & mask).any()) break;
+            if (room == rooms.end()) continue;
+            double cost = sharedConflicts(state, section, p) * 1e3 + (room->capacity - size) + jitter(rng);
+            if (cost < bestCost) {
+                bestCost = cost;
+                best.pattern = p;
+                best.room = static_cast<int>(room - rooms.begin());
+            }
+        }
+        return best;
+    }
+
+    void place(State& state, uint32_t section, Placement placement) const {
+        state.placements[section] = placement;
+        if (placement.pattern < 0) return;
+        const WeekMask& mask = patternMasks[placement.pattern];
+        state.roomBusy[placement.room] |= mask;
+        if (instructorOf[section] >= 0) state.instructorBusy[instructorOf[section]] |= mask;
+    }
+
+    void unplace(State& state, uint32_t section) const {
+        Placement placement = state.placements[section];
+        state.placements[section] = Placement();
+        if (placement.pattern < 0) return;
+        const WeekMask& mask = patternMasks[placement.pattern];
+        state.roomBusy[placement.room] &= ~mask;
+        if (instructorOf[section] >= 0) state.instructorBusy[instructorOf[section]] &= ~mask;
+    }
+
+    double placedCost(const State& state, uint32_t section) const {
+        Placement placement = state.placements[section];
+        if (placement.pattern < 0) return 1e9;
+        return sharedConflicts(state, section, placement.pattern) * 1e3
+             + (rooms[placement.room].capacity - static_cast<int>(sections[section].students.size()));
+    }
+
+    Solution evaluate(const State& state) const {
+        Solution solution;
+        solution.placements = state.placements;
+        for (uint32_t i = 0; i < sections.size(); ++i) {
+            Placement placement = state.placements[i];
+            if (placement.pattern < 0) {
+                ++solution.unassigned;
+                continue;
+            }
+            solution.wastedSeats += rooms[placement.room].capacity - static_cast<long>(sections[i].students.size());
+            solution.studentConflicts += sharedConflicts(state, i, placement.pattern);
+        }
+        solution.studentConflicts /= 2; // every clashing pair was counted from both sides
+        return solution;
+    }
+
+    Solution search(uint32_t seed, chrono::steady_clock::time_point deadline) const {
+        mt19937 rng(seed);
+        Solution best;
+        best.unassigned = sections.size();
+        best.placements.assign(sections.size(), Placement());
+        size_t restarts = 0;
+
+        vector<uint32_t> order(sections.size());
+        for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+
+        do {
+            State state;
+            state.placements.assign(sections.size(), Placement());
+            state.roomBusy.assign(rooms.size(), WeekMask());
+            state.instructorBusy.assign(instructorCount, WeekMask());
+
+            // Randomized greedy: biggest sections first, shuffled within similar sizes.
+            shuffle(order.begin(), order.end(), rng);
+            stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+                return sections[a].students.size() / 8 > sections[b].students.size() / 8;
+            });
+            double unused;
+            for (uint32_t section : order) place(state, section, bestPlacement(state, section, rng, unused));
+
+            // Local search: re-place one section at a time, keeping only improvements.
+            uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(sections.size() - 1));
+            for (size_t step = 0; step < sections.size() * 4; ++step) {
+                if ((step & 255) == 0 && chrono::steady_clock::now() >= deadline) break;
+                uint32_t section = pick(rng);
+                Placement current = state.placements[section];
+                double currentCost = placedCost(state, section);
+                unplace(state, section);
+                double candidateCost;
+                Placement candidate = bestPlacement(state, section, rng, candidateCost);
+                place(state, section, (candidate.pattern >= 0 && candidateCost < currentCost) ? candidate : current);
+            }
+
+            Solution solution = evaluate(state);
+            if (solution.cost() < best.cost()) best = move(solution);
+            ++restarts;
+        } while (chrono::steady_clock::now() < deadline);
+
+        best.restarts = restarts;
+        return best;
+    }
+
+public:
+    RoomAssignmentSolver(vector<SectionRequest> requests, const vector<Classroom>& classrooms, const vector<string>& patterns)
+        : sections(move(requests)) {
+        for (const Classroom& c : classrooms) rooms.push_back(Room{intern(c.getRoomNumber()), c.getCapacity()});
+        sort(rooms.begin(), rooms.end(), [](const Room& a, const Room& b) { return a.capacity < b.capacity; });
+
+        for (const string& text : patterns) {
+            vector<TimeSlot> slots;
+            if (!parseTimeSlots(text, slots)) continue;
+            WeekMask mask;
+            for (TimeSlot t : slots) mask |= maskOf(t);
+            patternText.push_back(text);
+            patternSlots.push_back(slots);
+            patternMasks.push_back(mask);
+        }
+        overlaps.assign(patternMasks.size(), vector<char>(patternMasks.size(), 0));
+        for (size_t a = 0; a < patternMasks.size(); ++a)
+            for (size_t b = 0; b < patternMasks.size(); ++b) overlaps[a][b] = (patternMasks[a] & patternMasks[b]).any();
+
+        unordered_map<Symbol, int> instructors;
+        for (const SectionRequest& s : sections) {
+            if (s.instructor == SymbolTable::npos) {
+                instructorOf.push_back(-1);
+                continue;
+            }
+            auto it = instructors.emplace(s.instructor, static_cast<int>(instructors.size())).first;
+            instructorOf.push_back(it->second);
+        }
+        instructorCount = instructors.size();
+
+        // Shared-student counts between sections via a student -> sections index.
+        unordered_map<Symbol, vector<uint32_t>> taking;
+        for (uint32_t i = 0; i < sections.size(); ++i)
+            for (Symbol student : sections[i].students) taking[student].push_back(i);
+        vector<unordered_map<uint32_t, int>> shared(sections.size());
+        for (const auto& entry : taking)
+            for (uint32_t a : entry.second)
+                for (uint32_t b : entry.second)
+                    if (a != b) ++shared[a][b];
+        neighbors.resize(sections.size());
+        for (uint32_t i = 0; i < sections.size(); ++i)
+            neighbors[i].assign(shared[i].begin(), shared[i].end());
+    }
+
+    // Builds requests from Course rosters merged with EnrollmentManager entries.
+    static vector<SectionRequest> sectionsFrom(const vector<const Course*>& courses, const EnrollmentManager& enrollment) {
+        vector<SectionRequest> requests;
+        for (const Course* course : courses) {
+            SectionRequest r;
+            r.course = course->getCodeSymbol();
+            r.instructor = course->getInstructor() ? course->getInstructor()->getIDSymbol() : SymbolTable::npos;
+            for (const Student* s : course->getStudents()) r.students.push_back(s->getIDSymbol());
+            const vector<Symbol>& enrolled = enrollment.getStudents(r.course);
+            r.students.insert(r.students.end(), enrolled.begin(), enrolled.end());
+            sort(r.students.begin(), r.students.end());
+            r.students.erase(unique(r.students.begin(), r.students.end()), r.students.end());
+            requests.push_back(move(r));
+        }
+        return requests;
+    }
+
+    Solution solve(const SolverOptions& options = SolverOptions()) const {
+        if (sections.empty() || rooms.empty() || patternMasks.empty()) {
+            Solution none;
+            none.placements.assign(sections.size(), Placement());
+            none.unassigned = sections.size();
+            return none;
+        }
+        unsigned threadCount = options.threads ? options.threads : max(1u, thread::hardware_concurrency());
+        auto deadline = chrono::steady_clock::now() + options.budget;
+        vector<Solution> results(threadCount);
+        vector<thread> workers;
+        for (unsigned t = 1; t < threadCount; ++t)
+            workers.emplace_back([&, t]() { results[t] = search(options.seed + t, deadline); });
+        results[0] = search(options.seed, deadline);
+        for (auto& w : workers) w.join();
+
+        size_t best = 0, restarts = 0;
+        for (size_t t = 0; t < results.size(); ++t) {
+            restarts += results[t].restarts;
+            if (results[t].cost() < results[best].cost()) best = t;
+        }
+        results[best].restarts = restarts;
+        return results[best];
+    }
+
+    struct BookingFailure {
+        uint32_t section;
+        ScheduleConflict conflict;
+    };
+
+    // Books the solution into a ScheduleEngine (rooms are added as needed).
+    // The engine may already hold bookings the solver never saw; sections
+    // that clash with them are left unbooked and returned.
+    vector<BookingFailure> applyTo(const Solution& solution, ScheduleEngine& engine) const {
+        vector<BookingFailure> failures;
+        for (uint32_t i = 0; i < sections.size(); ++i) {
+            Placement placement = solution.placements[i];
+            if (placement.pattern < 0) continue;
+            uint32_t room = engine.addRoom(Classroom(str(rooms[placement.room].number), rooms[placement.room].capacity));
+            ScheduleConflict conflict = engine.book(sections[i].course, room, sections[i].instructor, patternSlots[placement.pattern]);
+            if (conflict != ScheduleConflict::None) failures.push_back(BookingFailure{i, conflict});
+        }
+        return failures;
+    }
+
+    const string& roomNumber(const Placement& placement) const { return str(rooms[placement.room].number); }
+    const string& patternName(const Placement& placement) const { return patternText[placement.pattern]; }
+};
+
+// ===================== University Registry =====================
+
+template <typename T>
+struct Handle {
+    uint32_t index;
+};
+
+// Chunked arena for one type. Objects are constructed in place, never move
+// once inserted (so raw pointers between them stay valid), and are released
+// together by clear().
+template <typename T>
+class Pool {
+private:
+    static const size_t ChunkSize = 1024;
+
+    struct Chunk {
+        typename aligned_storage<sizeof(T), alignof(T)>::type slots[ChunkSize];
+    };
+
+    vector<unique_ptr<Chunk>> chunks;
+    uint32_t count = 0;
+
+    void* slot(uint32_t index) const { return &chunks[index / ChunkSize]->slots[index % ChunkSize]; }
+
+public:
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    ~Pool() { clear(); }
+
+    template <typename... Args>
+    Handle<T> emplace(Args&&... args) {
+        if (count == chunks.size() * ChunkSize) chunks.emplace_back(new Chunk);
+        new (slot(count)) T(forward<Args>(args)...);
+        return Handle<T>{count++};
+    }
+
+    T& operator[](Handle<T> handle) { return *static_cast<T*>(slot(handle.index)); }
+    const T& operator[](Handle<T> handle) const { return *static_cast<const T*>(slot(handle.index)); }
+    size_t size() const { return count; }
+
+    void clear() {
+        for (uint32_t i = 0; i < count; ++i) static_cast<T*>(slot(i))->~T();
+        chunks.clear();
+        count = 0;
+    }
+};
+
+// Owns every object in the university graph in per-type pools addressed by
+// stable handles. Insertion is by construction in place or by move only.
+class UniversityRegistry {
+private:
+    tuple<Pool<UndergraduateStudent>, Pool<GraduateStudent>,
+          Pool<AssistantProfessor>, Pool<AssociateProfessor>, Pool<FullProfessor>,
+          Pool<Course>, Pool<Department>, Pool<Classroom>> pools;
+
+public:
+    template <typename T, typename... Args>
+    Handle<T> emplace(Args&&... args) {
+        return get<Pool<T>>(pools).emplace(forward<Args>(args)...);
+    }
+
+    template <typename T, typename = typename enable_if<!is_lvalue_reference<T>::value>::type>
+    Handle<T> add(T&& object) {
+        return get<Pool<T>>(pools).emplace(move(object));
+    }
+
+    template <typename T>
+    T& operator[](Handle<T> handle) { return get<Pool<T>>(pools)[handle]; }
+
+    template <typename T>
+    const T& operator[](Handle<T> handle) const { return get<Pool<T>>(pools)[handle]; }
+
+    template <typename T>
+    size_t count() const { return get<Pool<T>>(pools).size(); }
+
+    template <typename T>
+    const Pool<T>& pool() const { return get<Pool<T>>(pools); }
+
+    // Tears down the whole graph in one step.
+    void clear() {
+        get<Pool<Department>>(pools).clear();
+        get<Pool<Course>>(pools).clear();
+        get<Pool<Classroom>>(pools).clear();
+        get<Pool<UndergraduateStudent>>(pools).clear();
+        get<Pool<GraduateStudent>>(pools).clear();
+        get<Pool<AssistantProfessor>>(pools).clear();
+        get<Pool<AssociateProfessor>>(pools).clear();
+        get<Pool<FullProfessor>>(pools).clear();
+    }
+};
+
+// ===================== Payroll Engine =====================
+
+enum class PersonType : uint8_t {
+    Undergraduate,
+    Graduate,
+    AssistantProf,
+    AssociateProf,
+    FullProf,
+    Count
+};
+
+const size_t PersonTypeCount = static_cast<size_t>(PersonType::Count);
+
+bool isStudentType(PersonType type) { return type == PersonType::Undergraduate || type == PersonType::Graduate; }
+
+// Classifies a leaf object; returns false for types outside the closed hierarchy.
+bool personTypeOf(const Person* person, PersonType& type) {
+    if (dynamic_cast<const UndergraduateStudent*>(person)) type = PersonType::Undergraduate;
+    else if (dynamic_cast<const GraduateStudent*>(person)) type = PersonType::Graduate;
+    else if (dynamic_cast<const AssistantProfessor*>(person)) type = PersonType::AssistantProf;
+    else if (dynamic_cast<const AssociateProfessor*>(person)) type = PersonType::AssociateProf;
+    else if (dynamic_cast<const FullProfessor*>(person)) type = PersonType::FullProf;
+    else return false;
+    return true;
+}
+
+struct PayrollReport {
+    double total = 0.0;
+    double byType[PersonTypeCount] = {};
+    vector<double> byDepartment; // indexed by department handle
+};
+
+// Struct-of-arrays payroll roster. Virtual calculatePayment() is called once
+// per person at insertion; batch runs then sweep flat columns. Rates are kept
+// in integer cents so partitions can be summed in any order and still match
+// the virtual-dispatch loop exactly.
+class PayrollRoster {
+private:
+    vector<uint8_t> types;
+    vector<int64_t> rateCents;
+    vector<uint32_t> departments; // dense handle; department for professors, program for students
+    vector<Symbol> ids;
+
+    unordered_map<Symbol, uint32_t> departmentHandles;
+    vector<Symbol> departmentNames;
+
+    uint32_t departmentHandle(Symbol department) {
+        auto it = departmentHandles.find(department);
+        if (it != departmentHandles.end()) return it->second;
+        uint32_t handle = static_cast<uint32_t>(departmentNames.size());
+        departmentHandles.emplace(department, handle);
+        departmentNames.push_back(department);
+        return handle;
+    }
+
+    struct PartialSums {
+        int64_t total = 0;
+        int64_t byType[PersonTypeCount] = {};
+        vector<int64_t> byDepartment;
+    };
+
+    // Single fused pass over the columns. The roster is memory-bound, so one
+    // streaming sweep with two small scatters beats a masked SIMD pass per type.
+    void computeRange(size_t begin, size_t end, PartialSums& sums) const {
+        const uint8_t* type = types.data();
+        const int64_t* cents = rateCents.data();
+        const uint32_t* dept = departments.data();
+        sums.byDepartment.assign(departmentNames.size(), 0);
+        int64_t* byDept = sums.byDepartment.data();
+        for (size_t i = begin; i < end; ++i) {
+            sums.byType[type[i]] += cents[i];
+            byDept[dept[i]] += cents[i];
+        }
+        for (size_t t = 0; t < PersonTypeCount; ++t) sums.total += sums.byType[t];
+    }
+
+public:
+    void reserve(size_t n) {
+        types.reserve(n);
+        rateCents.reserve(n);
+        departments.reserve(n);
+        ids.reserve(n);
+    }
+
+    void add(PersonType type, double rate, Symbol department, Symbol ID) {
+        types.push_back(static_cast<uint8_t>(type));
+        rateCents.push_back(static_cast<int64_t>(rate * 100.0 + (rate < 0 ? -0.5 : 0.5)));
+        departments.push_back(departmentHandle(department));
+        ids.push_back(ID);
+    }
+
+    // Classifies a leaf object once; returns false for types payroll does not know.
+    bool add(const Person* person) {
+        PersonType type;
+        if (!personTypeOf(person, type)) return false;
+        Symbol group = isStudentType(type) ? static_cast<const Student*>(person)->getProgramSymbol()
+                                           : static_cast<const Professor*>(person)->getDepartmentSymbol();
+        add(type, person->calculatePayment(), group, person->getIDSymbol());
+        return true;
+    }
+
+    size_t size() const { return rateCents.size(); }
+    const string& departmentName(uint32_t handle) const { return str(departmentNames[handle]); }
+
+    PayrollReport compute(unsigned threadCount = 1) const {
+        size_t n = size();
+        threadCount = max(1u, min<unsigned>(threadCount, static_cast<unsigned>(max<size_t>(1, n / 65536))));
+        vector<PartialSums> partial(threadCount);
+        vector<thread> workers;
+        size_t chunk = (n + threadCount - 1) / threadCount;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            size_t begin = min(n, t * chunk), end = min(n, begin + chunk);
+            if (t + 1 == threadCount) computeRange(begin, end, partial[t]);
+            else workers.emplace_back(&PayrollRoster::computeRange, this, begin, end, ref(partial[t]));
+        }
+        for (auto& w : workers) w.join();
+
+        PartialSums sums;
+        sums.byDepartment.assign(departmentNames.size(), 0);
+        for (const auto& p : partial) {
+            sums.total += p.total;
+            for (size_t t = 0; t < PersonTypeCount; ++t) sums.byType[t] += p.byType[t];
+            for (size_t d = 0; d < p.byDepartment.size(); ++d) sums.byDepartment[d] += p.byDepartment[d];
+        }
+
+        PayrollReport report;
+        report.total = sums.total / 100.0;
+        for (size_t t = 0; t < PersonTypeCount; ++t) report.byType[t] = sums.byType[t] / 100.0;
+        for (int64_t cents : sums.byDepartment) report.byDepartment.push_back(cents / 100.0);
+        return report;
+    }
+};
+
+// ===================== People Index =====================
+
+typedef uint32_t PersonHandle;
+
+// Conjunctive query over the people index; unset fields match everything.
+class PersonQuery {
+public:
+    enum Field { Program, Department, Specialization, Type, EnrollmentYear, GPARange };
+
+    struct Predicate {
+        Field field;
+        uint32_t key;     // symbol, type or year
+        double low, high; // GPARange only, inclusive
+    };
+
+    vector<Predicate> predicates;
+
+    // Names are looked up, not interned: a name no one has (npos) matches nothing.
+    PersonQuery& program(const string& name) { return add(Program, symbols().find(name)); }
+    PersonQuery& department(const string& name) { return add(Department, symbols().find(name)); }
+    PersonQuery& specialization(const string& name) { return add(Specialization, symbols().find(name)); }
+    PersonQuery& type(PersonType t) { return add(Type, static_cast<uint32_t>(t)); }
+    PersonQuery& enrollmentYear(int year) { return add(EnrollmentYear, static_cast<uint32_t>(year)); }
+
+    PersonQuery& gpaBetween(double low, double high) {
+        predicates.push_back(Predicate{GPARange, 0, low, high});
+        return *this;
+    }
+
+private:
+    PersonQuery& add(Field field, uint32_t key) {
+        predicates.push_back(Predicate{field, key, 0.0, 0.0});
+        return *this;
+    }
+};
+
+// Secondary indexes over students and professors. Equality fields keep sorted
+// posting lists of handles; GPA keeps a (GPA, handle) array sorted lazily.
+// run() estimates each predicate's cardinality, drives from the smallest and
+// intersects or filters the rest in ascending order of size.
+class PeopleIndex {
+private:
+    typedef vector<PersonHandle> Postings;
+
+    vector<const Person*> people;
+    vector<double> gpaOf; // by handle; NaN for professors
+    unordered_map<Symbol, Postings> byProgram, byDepartment, bySpecialization;
+    unordered_map<uint32_t, Postings> byYear;
+    Postings byType[PersonTypeCount];
+    mutable vector<pair<double, PersonHandle>> byGPA;
+    mutable bool gpaSorted = true;
+
+    static const Postings& lookup(const unordered_map<uint32_t, Postings>& index, uint32_t key) {
+        static const Postings none;
+        auto it = index.find(key);
+        return it != index.end() ? it->second : none;
+    }
+
+    const Postings* postingsFor(const PersonQuery::Predicate& p) const {
+        switch (p.field) {
+            case PersonQuery::Program: return &lookup(byProgram, p.key);
+            case PersonQuery::Department: return &lookup(byDepartment, p.key);
+            case PersonQuery::Specialization: return &lookup(bySpecialization, p.key);
+            case PersonQuery::EnrollmentYear: return &lookup(byYear, p.key);
+            case PersonQuery::Type: return p.key < PersonTypeCount ? &byType[p.key] : nullptr;
+            default: return nullptr;
+        }
+    }
+
+    pair<vector<pair<double, PersonHandle>>::const_iterator, vector<pair<double, PersonHandle>>::const_iterator>
+    gpaRange(double low, double high) const {
+        if (!gpaSorted) {
+            sort(byGPA.begin(), byGPA.end());
+            gpaSorted = true;
+        }
+        auto first = lower_bound(byGPA.begin(), byGPA.end(), make_pair(low, PersonHandle(0)));
+        auto last = upper_bound(byGPA.begin(), byGPA.end(), make_pair(high, PersonHandle(UINT32_MAX)));
+        return make_pair(first, last);
+    }
+
+    size_t estimate(const PersonQuery::Predicate& p) const {
+        if (p.field == PersonQuery::GPARange) {
+            auto range = gpaRange(p.low, p.high);
+            return static_cast<size_t>(range.second - range.first);
+        }
+        const Postings* list = postingsFor(p);
+        return list ? list->size() : 0;
+    }
+
+    // Merge when the lists are comparable, otherwise probe the larger list by binary search.
+    static void intersect(Postings& result, const Postings& other) {
+        Postings out;
+        if (other.size() > result.size() * 16) {
+            auto from = other.begin();
+            for (PersonHandle h : result) {
+                from = lower_bound(from, other.end(), h);
+                if (from == other.end()) break;
+                if (*from == h) out.push_back(h);
+            }
+        } else {
+            set_intersection(result.begin(), result.end(), other.begin(), other.end(), back_inserter(out));
+        }
+        result.swap(out);
+    }
+
+public:
+    // Returns the new handle, or UINT32_MAX for unknown person types.
+    PersonHandle add(const Person* person) {
+        PersonType type;
+        if (!personTypeOf(person, type)) return UINT32_MAX;
+        PersonHandle handle = static_cast<PersonHandle>(people.size());
+        people.push_back(person);
+        byType[static_cast<size_t>(type)].push_back(handle);
+        if (isStudentType(type)) {
+            const Student* s = static_cast<const Student*>(person);
+            byProgram[s->getProgramSymbol()].push_back(handle);
+            byYear[static_cast<uint32_t>(atoi(s->getEnrollmentDate().c_str()))].push_back(handle);
+            gpaOf.push_back(s->getGPA());
+            byGPA.emplace_back(s->getGPA(), handle);
+            gpaSorted = false;
+        } else {
+            const Professor* p = static_cast<const Professor*>(person);
+            byDepartment[p->getDepartmentSymbol()].push_back(handle);
+            bySpecialization[p->getSpecializationSymbol()].push_back(handle);
+            gpaOf.push_back(numeric_limits<double>::quiet_NaN());
+        }
+        return handle;
+    }
+
+    size_t size() const { return people.size(); }
+    const Person& person(PersonHandle handle) const { return *people[handle]; }
+
+    vector<PersonHandle> run(const PersonQuery& query) const {
+        vector<PersonHandle> result;
+        if (query.predicates.empty()) {
+            result.resize(people.size());
+            for (PersonHandle h = 0; h < result.size(); ++h) result[h] = h;
+            return result;
+        }
+
+        vector<pair<size_t, const PersonQuery::Predicate*>> plan;
+        for (const auto& p : query.predicates) plan.emplace_back(estimate(p), &p);
+        sort(plan.begin(), plan.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        const PersonQuery::Predicate& driver = *plan[0].second;
+        if (driver.field == PersonQuery::GPARange) {
+            auto range = gpaRange(driver.low, driver.high);
+            for (auto it = range.first; it != range.second; ++it) result.push_back(it->second);
+            sort(result.begin(), result.end());
+        } else {
+            const Postings* list = postingsFor(driver);
+            if (!list) return result; // e.g. an out-of-range type
+            result = *list;
+        }
+
+        for (size_t i = 1; i < plan.size() && !result.empty(); ++i) {
+            const PersonQuery::Predicate& p = *plan[i].second;
+            if (p.field == PersonQuery::GPARange) {
+                result.erase(remove_if(result.begin(), result.end(), [&](PersonHandle h) {
+                    return !(gpaOf[h] >= p.low && gpaOf[h] <= p.high);
+                }), result.end());
+            } else if (const Postings* list = postingsFor(p)) {
+                intersect(result, *list);
+            } else {
+                result.clear();
+            }
+        }
+        return result;
+    }
+};
+
+// ===================== Binary Snapshot =====================
+
+// Flat, offset-based image of the registry plus GradeBook, EnrollmentManager
+// and Schedule. Every section is an array of fixed-size records, and strings
+// are (offset, length) references into one blob, so a mapped file is queried
+// in place without parsing. All integers are host-endian.
+
+const char SnapshotMagic[8] = { 'U', 'N', 'I', 'S', 'N', 'A', 'P', '\0' };
+const uint32_t SnapshotVersion = 1;
+const uint32_t SnapshotNone = UINT32_MAX;
+
+enum SnapshotSection : uint32_t {
+    SectionStrings,
+    SectionPeople,
+    SectionPersonIndex,       // person indices sorted by ID, for binary search
+    SectionCourses,
+    SectionRosters,           // (course, person) pairs from Course::students
+    SectionDepartments,
+    SectionDepartmentProfessors,
+    SectionClassrooms,
+    SectionEnrollments,       // EnrollmentManager entries
+    SectionGrades,
+    SectionSchedule,
+    SectionCount
+};
+
+struct SnapshotStr {
+    uint32_t offset, length;
+};
+
+struct SnapshotSectionEntry {
+    uint64_t offset, count;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t fileSize;
+    uint64_t checksum; // over every byte after the header
+    SnapshotSectionEntry sections[SectionCount];
+};
+
+// extra[] holds enrollmentDate, program, then major/minor/gradDate or
+// topic/advisor/thesis for students; department, specialization, hireDate for professors.
+struct PersonRecord {
+    uint32_t type; // PersonType
+    int32_t age;
+    double GPA;
+    SnapshotStr name, ID, contact;
+    SnapshotStr extra[6];
+};
+
+struct CourseRecord {
+    SnapshotStr code, title, description;
+    int32_t credits;
+    uint32_t instructor; // person index or SnapshotNone
+    uint32_t department; // department index or SnapshotNone
+    uint32_t reserved;
+};
+
+struct RosterRecord {
+    uint32_t course, person;
+};
+
+struct DepartmentRecord {
+    SnapshotStr name;
+    uint32_t firstCourse, courseCount;
+    uint32_t firstProfessor, professorCount;
+};
+
+struct ClassroomRecord {
+    SnapshotStr room;
+    int32_t capacity;
+    uint32_t reserved;
+};
+
+struct EnrollmentRecord {
+    SnapshotStr courseCode, studentID;
+};
+
+struct GradeRecord {
+    SnapshotStr studentID;
+    double grade;
+};
+
+struct ScheduleRecord {
+    SnapshotStr courseCode, time, room;
+};
+
+// 64-bit FNV-1a folded over 8-byte words, with a byte-wise tail.
+uint64_t snapshotChecksum(const unsigned char* data, size_t length) {
+    uint64_t hash = 1469598103934665603ull;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < length; ++i) hash = (hash ^ data[i]) * 1099511628211ull;
+    return hash;
+}
+
+class SnapshotWriter {
+private:
+    string blob;
+    unordered_map<Symbol, SnapshotStr> symbolRefs;
+    unordered_map<const Person*, uint32_t> personIndex;
+
+    vector<PersonRecord> people;
+    vector<uint32_t> personOrder;
+    vector<CourseRecord> courses;
+    vector<RosterRecord> rosters;
+    vector<DepartmentRecord> departments;
+    vector<uint32_t> departmentProfessors;
+    vector<ClassroomRecord> classrooms;
+    vector<EnrollmentRecord> enrollments;
+    vector<GradeRecord> grades;
+    vector<ScheduleRecord> schedule;
+
+    SnapshotStr text(const string& value) {
+        SnapshotStr ref{static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(value.size())};
+        blob += value;
+        return ref;
+    }
+
+    SnapshotStr text(Symbol symbol) {
+        auto it = symbolRefs.find(symbol);
+        if (it != symbolRefs.end()) return it->second;
+        SnapshotStr ref = text(str(symbol));
+        symbolRefs.emplace(symbol, ref);
+        return ref;
+    }
+
+    PersonRecord personBase(const Person& p, PersonType type) {
+        PersonRecord r = {};
+        r.type = static_cast<uint32_t>(type);
+        r.age = p.age;
+        r.name = text(p.details->name);
+        r.ID = text(p.ID);
+        r.contact = text(p.details->contact);
+        return r;
+    }
+
+    PersonRecord studentBase(const Student& s, PersonType type) {
+        PersonRecord r = personBase(s, type);
+        r.GPA = s.GPA;
+        r.extra[0] = text(s.enrollmentDate);
+        r.extra[1] = text(s.program);
+        return r;
+    }
+
+    void addPerson(const Person& p, const PersonRecord& record) {
+        personIndex.emplace(&p, static_cast<uint32_t>(people.size()));
+        people.push_back(record);
+    }
+
+    void add(const UndergraduateStudent& s) {
+        PersonRecord r = studentBase(s, PersonType::Undergraduate);
+        r.extra[2] = text(s.major);
+        r.extra[3] = text(s.minor);
+        r.extra[4] = text(s.expectedGraduation);
+        addPerson(s, r);
+    }
+
+    void add(const GraduateStudent& s) {
+        PersonRecord r = studentBase(s, PersonType::Graduate);
+        r.extra[2] = text(s.thesis->researchTopic);
+        r.extra[3] = text(s.advisor);
+        r.extra[4] = text(s.thesis->thesisTitle);
+        addPerson(s, r);
+    }
+
+    void add(const Professor& p, PersonType type) {
+        PersonRecord r = personBase(p, type);
+        r.extra[0] = text(p.department);
+        r.extra[1] = text(p.specialization);
+        r.extra[2] = text(p.hireDate);
+        addPerson(p, r);
+    }
+
+    uint32_t indexOf(const Person* p) const {
+        auto it = personIndex.find(p);
+        return it != personIndex.end() ? it->second : SnapshotNone;
+    }
+
+    void add(const Course& c, uint32_t department) {
+        uint32_t index = static_cast<uint32_t>(courses.size());
+        courses.push_back(CourseRecord{text(c.code), text(c.details->title), text(c.details->description), c.credits,
+                                       indexOf(c.instructor), department, 0});
+        for (const Student* s : c.students) {
+            uint32_t person = indexOf(s);
+            if (person != SnapshotNone) rosters.push_back(RosterRecord{index, person});
+        }
+    }
+
+    template <typename T>
+    static void writeSection(string& image, SnapshotHeader& header, SnapshotSection section, const vector<T>& records) {
+        image.resize((image.size() + 7) & ~size_t(7), '\0');
+        header.sections[section].offset = image.size();
+        header.sections[section].count = records.size();
+        image.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    }
+
+public:
+    bool write(const string& path, const UniversityRegistry& registry, const GradeBook& gradeBook,
+               const EnrollmentManager& enrollment, const Schedule& sched) {
+        const auto& undergrads = registry.pool<UndergraduateStudent>();
+        for (uint32_t i = 0; i < undergrads.size(); ++i) add(undergrads[Handle<UndergraduateStudent>{i}]);
+        const auto& grads = registry.pool<GraduateStudent>();
+        for (uint32_t i = 0; i < grads.size(); ++i) add(grads[Handle<GraduateStudent>{i}]);
+        const auto& assistants = registry.pool<AssistantProfessor>();
+        for (uint32_t i = 0; i < assistants.size(); ++i) add(assistants[Handle<AssistantProfessor>{i}], PersonType::AssistantProf);
+        const auto& associates = registry.pool<AssociateProfessor>();
+        for (uint32_t i = 0; i < associates.size(); ++i) add(associates[Handle<AssociateProfessor>{i}], PersonType::AssociateProf);
+        const auto& fulls = registry.pool<FullProfessor>();
+        for (uint32_t i = 0; i < fulls.size(); ++i) add(fulls[Handle<FullProfessor>{i}], PersonType::FullProf);
+
+        personOrder.resize(people.size());
+        for (uint32_t i = 0; i < personOrder.size(); ++i) personOrder[i] = i;
+        sort(personOrder.begin(), personOrder.end(), [this](uint32_t a, uint32_t b) {
+            return blob.compare(people[a].ID.offset, people[a].ID.length, blob, people[b].ID.offset, people[b].ID.length) < 0;
+        });
+
+        const auto& courseGraph = registry.pool<Course>();
+        for (uint32_t i = 0; i < courseGraph.size(); ++i) add(courseGraph[Handle<Course>{i}], SnapshotNone);
+
+        const auto& depts = registry.pool<Department>();
+        for (uint32_t i = 0; i < depts.size(); ++i) {
+            const Department& d = depts[Handle<Department>{i}];
+            DepartmentRecord r{text(d.name), static_cast<uint32_t>(courses.size()), static_cast<uint32_t>(d.courses.size()),
+                               static_cast<uint32_t>(departmentProfessors.size()), 0};
+            for (const Course& c : d.courses) add(c, i);
+            for (const Professor* p : d.professors) {
+                uint32_t person = indexOf(p);
+                if (person != SnapshotNone) {
+                    departmentProfessors.push_back(person);
+                    ++r.professorCount;
+                }
+            }
+            departments.push_back(r);
+        }
+
+        const auto& rooms = registry.pool<Classroom>();
+        for (uint32_t i = 0; i < rooms.size(); ++i) {
+            const Classroom& room = rooms[Handle<Classroom>{i}];
+            classrooms.push_back(ClassroomRecord{text(room.roomNumber), room.capacity, 0});
+        }
+
+        for (const auto& entry : enrollment.courseEnrollments)
+            for (Symbol student : entry.second)
+                enrollments.push_back(EnrollmentRecord{text(entry.first), text(student)});
+        for (const auto& entry : gradeBook.grades)
+            grades.push_back(GradeRecord{text(entry.first), entry.second});
+        for (const auto& entry : sched.courseSchedule)
+            schedule.push_back(ScheduleRecord{text(entry.first), text(entry.second.first), text(entry.second.second)});
+
+        SnapshotHeader header = {};
+        memcpy(header.magic, SnapshotMagic, sizeof(header.magic));
+        header.version = SnapshotVersion;
+        header.headerSize = sizeof(SnapshotHeader);
+
+        string image(sizeof(SnapshotHeader), '\0');
+        image.resize((image.size() + 7) & ~size_t(7), '\0');
+        header.sections[SectionStrings].offset = image.size();
+        header.sections[SectionStrings].count = blob.size();
+        image += blob;
+        writeSection(image, header, SectionPeople, people);
+        writeSection(image, header, SectionPersonIndex, personOrder);
+        writeSection(image, header, SectionCourses, courses);
+        writeSection(image, header, SectionRosters, rosters);
+        writeSection(image, header, SectionDepartments, departments);
+        writeSection(image, header, SectionDepartmentProfessors, departmentProfessors);
+        writeSection(image, header, SectionClassrooms, classrooms);
+        writeSection(image, header, SectionEnrollments, enrollments);
+        writeSection(image, header, SectionGrades, grades);
+        writeSection(image, header, SectionSchedule, schedule);
+
+        header.fileSize = image.size();
+        header.checksum = snapshotChecksum(reinterpret_cast<const unsigned char*>(image.data()) + sizeof(SnapshotHeader),
+                                           image.size() - sizeof(SnapshotHeader));
+        memcpy(&image[0], &header, sizeof(header));
+
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out) return false;
+        bool ok = fwrite(image.data(), 1, image.size(), out) == image.size();
+        return fclose(out) == 0 && ok;
+    }
+};
+
+// Read-only view over a mapped snapshot. open() validates the header and
+// section bounds (and optionally the checksum); nothing is deserialized.
+class Snapshot {
+private:
+    const unsigned char* base = nullptr;
+    size_t length = 0;
+    string lastError;
+
+    const SnapshotHeader& header() const { return *reinterpret_cast<const SnapshotHeader*>(base); }
+
+    bool fail(const string& message) {
+        lastError = message;
+        close();
+        return false;
+    }
+
+public:
+    Snapshot() = default;
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot() { close(); }
+
+    bool open(const string& path, bool verifyChecksum = true) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail("cannot open " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            return fail("snapshot too small");
+        }
+        length = static_cast<size_t>(info.st_size);
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return fail("mmap failed");
+        base = static_cast<const unsigned char*>(mapped);
+
+        const SnapshotHeader& h = header();
+        if (memcmp(h.magic, SnapshotMagic, sizeof(h.magic)) != 0) return fail("bad magic");
+        if (h.version != SnapshotVersion) return fail("unsupported version " + to_string(h.version));
+        if (h.headerSize != sizeof(SnapshotHeader) || h.fileSize != length) return fail("size mismatch");
+
+        static const size_t recordSize[SectionCount] = {
+            1, sizeof(PersonRecord), sizeof(uint32_t), sizeof(CourseRecord), sizeof(RosterRecord),
+            sizeof(DepartmentRecord), sizeof(uint32_t), sizeof(ClassroomRecord), sizeof(EnrollmentRecord),
+            sizeof(GradeRecord), sizeof(ScheduleRecord)
+        };
+        for (size_t s = 0; s < SectionCount; ++s) {
+            const SnapshotSectionEntry& e = h.sections[s];
+            if (e.offset < sizeof(SnapshotHeader) || e.offset > length || e.count > (length - e.offset) / recordSize[s])
+                return fail("section " + to_string(s) + " out of bounds");
+        }
+        if (verifyChecksum && snapshotChecksum(base + sizeof(SnapshotHeader), length - sizeof(SnapshotHeader)) != h.checksum)
+            return fail("checksum mismatch");
+        return true;
+    }
+
+    void close() {
+        if (base) munmap(const_cast<unsigned char*>(base), length);
+        base = nullptr;
+        length = 0;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    const string& error() const { return lastError; }
+
+    template <typename R>
+    const R* records(SnapshotSection section) const {
+        return reinterpret_cast<const R*>(base + header().sections[section].offset);
+    }
+
+    size_t count(SnapshotSection section) const { return header().sections[section].count; }
+
+    string_view text(SnapshotStr ref) const {
+        const SnapshotSectionEntry& strings = header().sections[SectionStrings];
+        if (uint64_t(ref.offset) + ref.length > strings.count) return string_view();
+        return string_view(reinterpret_cast<const char*>(base + strings.offset) + ref.offset, ref.length);
+    }
+
+    // Binary search over the sorted person index; nullptr if absent.
+    const PersonRecord* findPerson(string_view ID) const {
+        const PersonRecord* people = records<PersonRecord>(SectionPeople);
+        const uint32_t* order = records<uint32_t>(SectionPersonIndex);
+        size_t lo = 0, hi = count(SectionPersonIndex);
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (order[mid] >= count(SectionPeople)) return nullptr;
+            int cmp = text(people[order[mid]].ID).compare(ID);
+            if (cmp == 0) return &people[order[mid]];
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return nullptr;
+    }
+};
+
+// ===================== Report Writer =====================
+
+// Growable output buffer for reports. Numbers are formatted with to_chars;
+// when bound to a file descriptor, spill() writes the buffer out once it
+// reaches chunkSize, so arbitrarily large reports use bounded memory.
+class ReportBuffer {
+private:
+    string data;
+    int fd;
+    size_t chunkSize;
+    bool failed = false;
+
+public:
+    explicit ReportBuffer(int fd = -1, size_t chunkSize = 1 << 20) : fd(fd), chunkSize(chunkSize) {
+        data.reserve(chunkSize + 4096);
+    }
+
+    ReportBuffer(const ReportBuffer&) = delete;
+    ReportBuffer& operator=(const ReportBuffer&) = delete;
+
+    ~ReportBuffer() { flush(); }
+
+    void append(string_view text) { data.append(text.data(), text.size()); }
+
+    void put(char c) { data.push_back(c); }
+
+    void appendInt(long long value) {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), value);
+        data.append(digits, result.ptr);
+    }
+
+    // Shortest representation that round-trips.
+    void appendDouble(double value) {
+        char digits[32];
+        auto result = to_chars(digits, digits + sizeof(digits), value);
+        data.append(digits, result.ptr);
+    }
+
+    // printf("%g")-style with the given significant digits, as ostream prints by default.
+    void appendDouble(double value, int precision) {
+        char digits[32];
+        auto result = to_chars(digits, digits + sizeof(digits), value, chars_format::general, precision);
+        data.append(digits, result.ptr);
+    }
+
+    // Writes everything buffered to the descriptor, retrying short writes. A
+    // buffer without a descriptor keeps its contents for str().
+    bool flush() {
+        if (fd < 0 || failed) return !failed;
+        size_t done = 0;
+        while (done < data.size()) {
+            ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+        data.clear();
+        return !failed;
+    }
+
+    // Called between records, so a record is never split across writes.
+    void spill() {
+        if (fd >= 0 && data.size() >= chunkSize) flush();
+    }
+
+    const string& str() const { return data; }
+    void clear() { data.clear(); }
+    bool ok() const { return !failed; }
+};
+
+enum class ReportFormat { Text, Csv, Json };
+
+// Renders people, courses and departments into a ReportBuffer.
+//   Text: the same lines displayDetails() prints.
+//   Csv:  one record per line in the SIS feed layout read by the importer
+//         (undergrad|grad|assistant|associate|full|course,...), plus
+//         "department,name" rows introducing a department's professors and courses.
+//   Json: one array of objects tagged with "type".
+// Call begin() before the first record and end() after the last.
+class ReportWriter {
+private:
+    ReportBuffer& out;
+    ReportFormat format;
+    bool firstRecord = true;
+
+    static const char* typeName(PersonType type) {
+        static const char* names[] = { "undergrad", "grad", "assistant", "associate", "full" };
+        return names[static_cast<size_t>(type)];
+    }
+
+    void csvField(string_view value) {
+        out.put(',');
+        if (value.find_first_of(",\"\n\r") == string_view::npos) {
+            out.append(value);
+            return;
+        }
+        out.put('"');
+        for (char c : value) {
+            if (c == '"') out.put('"');
+            out.put(c);
+        }
+        out.put('"');
+    }
+
+    // Copies runs of plain characters in one append, escaping the rest.
+    void jsonString(string_view value) {
+        static const char hex[] = "0123456789abcdef";
+        out.put('"');
+        size_t run = 0;
+        for (size_t i = 0; i < value.size(); ++i) {
+            unsigned char u = static_cast<unsigned char>(value[i]);
+            if (u >= 0x20 && u != '"' && u != '\\') continue;
+            out.append(value.substr(run, i - run));
+            out.put('\\');
+            if (u >= 0x20) {
+                out.put(value[i]);
+            } else {
+                out.append("u00");
+                out.put(hex[u >> 4]);
+                out.put(hex[u & 15]);
+            }
+            run = i + 1;
+        }
+        out.append(value.substr(run));
+        out.put('"');
+    }
+
+    void jsonKey(const char* key) {
+        out.put(',');
+        jsonString(key);
+        out.put(':');
+    }
+
+    void jsonField(const char* key, string_view value) {
+        jsonKey(key);
+        jsonString(value);
+    }
+
+    void beginRecord(const char* type) {
+        if (format == ReportFormat::Json) {
+            if (!firstRecord) out.put(',');
+            out.append("\n{\"type\":");
+            jsonString(type);
+        } else if (format == ReportFormat::Csv) {
+            out.append(type);
+        }
+        firstRecord = false;
+    }
+
+    void endRecord() {
+        if (format == ReportFormat::Json) out.put('}');
+        else if (format == ReportFormat::Csv) out.put('\n');
+        out.spill();
+    }
+
+    // Text lines shared by every person: "Name: ..., Age: ..., ID: ..., Contact: ...".
+    void personHead(const Person& p) {
+        if (format == ReportFormat::Text) {
+            out.append("Name: ");
+            out.append(p.details->name);
+            out.append(", Age: ");
+            out.appendInt(p.age);
+            out.append(", ID: ");
+            out.append(str(p.ID));
+            out.append(", Contact: ");
+            out.append(p.details->contact);
+            out.put('\n');
+        } else if (format == ReportFormat::Csv) {
+            csvField(p.details->name);
+            out.put(',');
+            out.appendInt(p.age);
+            csvField(str(p.ID));
+            csvField(p.details->contact);
+        } else {
+            jsonField("name", p.details->name);
+            jsonKey("age");
+            out.appendInt(p.age);
+            jsonField("id", str(p.ID));
+            jsonField("contact", p.details->contact);
+        }
+    }
+
+    void studentHead(const Student& s, PersonType type) {
+        beginRecord(typeName(type));
+        personHead(s);
+        if (format == ReportFormat::Text) {
+            out.append("Program: ");
+            out.append(str(s.program));
+            out.append(", GPA: ");
+            out.appendDouble(s.GPA, 6);
+            out.put('\n');
+        } else if (format == ReportFormat::Csv) {
+            csvField(str(s.enrollmentDate));
+            csvField(str(s.program));
+            out.put(',');
+            out.appendDouble(s.GPA);
+        } else {
+            jsonField("enrollmentDate", str(s.enrollmentDate));
+            jsonField("program", str(s.program));
+            jsonKey("gpa");
+            out.appendDouble(s.GPA);
+        }
+    }
+
+    // The three type-specific fields: Text labels, then CSV/JSON keys.
+    void details(const char* const labels[3], const char* const keys[3], const string_view values[3]) {
+        if (format == ReportFormat::Text) {
+            for (int i = 0; i < 3; ++i) {
+                if (i) out.append(", ");
+                out.append(labels[i]);
+                out.append(values[i]);
+            }
+            out.put('\n');
+        } else if (format == ReportFormat::Csv) {
+            for (int i = 0; i < 3; ++i) csvField(values[i]);
+        } else {
+            for (int i = 0; i < 3; ++i) jsonField(keys[i], values[i]);
+        }
+    }
+
+public:
+    ReportWriter(ReportBuffer& out, ReportFormat format) : out(out), format(format) {}
+
+    void begin() {
+        firstRecord = true;
+        if (format == ReportFormat::Json) out.put('[');
+    }
+
+    bool end() {
+        if (format == ReportFormat::Json) out.append("\n]\n");
+        return out.flush();
+    }
+
+    void add(const UndergraduateStudent& s) {
+        static const char* const labels[3] = { "Major: ", "Minor: ", "Grad Date: " };
+        static const char* const keys[3] = { "major", "minor", "expectedGraduation" };
+        studentHead(s, PersonType::Undergraduate);
+        const string_view values[3] = { str(s.major), str(s.minor), str(s.expectedGraduation) };
+        details(labels, keys, values);
+        endRecord();
+    }
+
+    void add(const GraduateStudent& s) {
+        static const char* const labels[3] = { "Research: ", "Advisor: ", "Thesis: " };
+        static const char* const keys[3] = { "researchTopic", "advisor", "thesisTitle" };
+        studentHead(s, PersonType::Graduate);
+        const string_view values[3] = { s.thesis->researchTopic, str(s.advisor), s.thesis->thesisTitle };
+        details(labels, keys, values);
+        endRecord();
+    }
+
+    void add(const Professor& p, PersonType type) {
+        static const char* const labels[3] = { "Dept: ", "Specialization: ", "Hire Date: " };
+        static const char* const keys[3] = { "department", "specialization", "hireDate" };
+        beginRecord(typeName(type));
+        personHead(p);
+        const string_view values[3] = { str(p.department), str(p.specialization), str(p.hireDate) };
+        details(labels, keys, values);
+        endRecord();
+    }
+
+    // Classifies through personTypeOf(); returns false for unknown person types.
+    bool add(const Person& p) {
+        PersonType type;
+        if (!personTypeOf(&p, type)) return false;
+        if (type == PersonType::Undergraduate) add(static_cast<const UndergraduateStudent&>(p));
+        else if (type == PersonType::Graduate) add(static_cast<const GraduateStudent&>(p));
+        else add(static_cast<const Professor&>(p), type);
+        return true;
+    }
+
+    void add(const Course& c) {
+        beginRecord("course");
+        if (format == ReportFormat::Text) {
+            out.append("Course: ");
+            out.append(str(c.code));
+            out.append(", Title: ");
+            out.append(c.details->title);
+            out.append(", Credits: ");
+            out.appendInt(c.credits);
+            out.append(", Instructor: ");
+            out.append(c.instructor ? string_view(str(c.instructor->ID)) : string_view("none"));
+            out.append(", Students: ");
+            out.appendInt(static_cast<long long>(c.students.size()));
+            out.put('\n');
+        } else if (format == ReportFormat::Csv) {
+            csvField(str(c.code));
+            csvField(c.details->title);
+            out.put(',');
+            out.appendInt(c.credits);
+            csvField(c.details->description);
+        } else {
+            jsonField("code", str(c.code));
+            jsonField("title", c.details->title);
+            jsonKey("credits");
+            out.appendInt(c.credits);
+            jsonField("description", c.details->description);
+            jsonKey("instructor");
+            if (c.instructor) jsonString(str(c.instructor->ID));
+            else out.append("null");
+            jsonKey("students");
+            out.put('[');
+            for (size_t i = 0; i < c.students.size(); ++i) {
+                if (i) out.put(',');
+                jsonString(str(c.students[i]->ID));
+            }
+            out.put(']');
+        }
+        endRecord();
+    }
+
+    // A department header followed by its professors and courses; in JSON
+    // they nest under the department object.
+    void add(const Department& d) {
+        if (format == ReportFormat::Json) {
+            beginRecord("department");
+            jsonField("name", str(d.name));
+            jsonKey("professors");
+            out.put('[');
+            firstRecord = true;
+            for (const Professor* p : d.professors) add(*p);
+            out.append("]");
+            jsonKey("courses");
+            out.put('[');
+            firstRecord = true;
+            for (const Course& c : d.courses) add(c);
+            out.append("]}");
+            firstRecord = false;
+            return;
+        }
+        if (format == ReportFormat::Text) {
+            out.append("Department: ");
+            out.append(str(d.name));
+            out.put('\n');
+        } else {
+            out.append("department");
+            csvField(str(d.name));
+            out.put('\n');
+        }
+        for (const Professor* p : d.professors) add(*p);
+        for (const Course& c : d.courses) add(c);
+    }
+};
+
+// Compares the columnar engine against the virtual-dispatch loop on a large roster.
+void benchmarkPayroll(size_t rosterSize) {
+    vector<unique_ptr<Person>> pool;
+    const char* depts[] = { "CS", "Physics", "Math", "Biology" };
+    for (int i = 0; i < 200; ++i) {
+        string id = to_string(i), dept = depts[i % 4];
+        pool.emplace_back(new UndergraduateStudent("U", 20, "U" + id, "u@email.com", "2022", dept, 3.0, dept, "None", "2026"));
+        pool.emplace_back(new GraduateStudent("G", 25, "G" + id, "g@email.com", "2021", dept, 3.5, "Topic", "Advisor", "Thesis"));
+        pool.emplace_back(new AssistantProfessor("A", 35, "A" + id, "a@email.com", dept, "Spec", "2018"));
+        pool.emplace_back(new AssociateProfessor("B", 45, "B" + id, "b@email.com", dept, "Spec", "2010"));
+        pool.emplace_back(new FullProfessor("F", 55, "F" + id, "f@email.com", dept, "Spec", "2000"));
+    }
+
+    vector<Person*> people;
+    people.reserve(rosterSize);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < rosterSize; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        people.push_back(pool[seed % pool.size()].get());
+    }
+
+    PayrollRoster roster;
+    roster.reserve(rosterSize);
+    for (Person* p : people) roster.add(p);
+
+    auto start = chrono::steady_clock::now();
+    double virtualTotal = 0.0;
+    for (Person* p : people) virtualTotal += p->calculatePayment();
+    double virtualSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    start = chrono::steady_clock::now();
+    PayrollReport report = roster.compute(cores);
+    double columnarSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "payroll n=" << rosterSize << " virtual=" << virtualSeconds * 1e3 << "ms columnar(" << cores
+         << " threads, with breakdowns)=" << columnarSeconds * 1e3 << "ms match="
+         << (report.total == virtualTotal ? "yes" : "no") << endl;
+}
+
+size_t stringFootprint(const string& value) {
+    return sizeof(string) + (value.capacity() > 15 ? value.capacity() + 1 : 0);
+}
+
+// Memory taken by the six interned UndergraduateStudent fields, compared with
+// storing them as std::string per object as the model used to.
+void benchmarkSymbolFootprint(size_t studentCount) {
+    const char* programs[] = { "Computer Science and Engineering", "Mechanical Engineering", "Applied Mathematics" };
+    size_t tableBefore = symbols().bytesUsed();
+    size_t legacyBytes = 0;
+    vector<unique_ptr<UndergraduateStudent>> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        string id = "S" + to_string(1000000 + i);
+        string enrolled = to_string(2019 + i % 5) + "-09-01";
+        string program = programs[i % 3];
+        string grad = to_string(2023 + i % 5) + "-06-15";
+        legacyBytes += stringFootprint(id) + stringFootprint(enrolled) + stringFootprint(program)
+                     + stringFootprint(program) + stringFootprint("None") + stringFootprint(grad);
+        students.emplace_back(new UndergraduateStudent("Student", 20, id, "s@email.com", enrolled, program, 3.0, program, "None", grad));
+    }
+    size_t internedBytes = studentCount * 6 * sizeof(Symbol) + (symbols().bytesUsed() - tableBefore);
+    cout << "symbols n=" << studentCount << " legacy=" << legacyBytes / (1024 * 1024) << "MiB interned="
+         << internedBytes / (1024 * 1024) << "MiB sizeof(UndergraduateStudent)=" << sizeof(UndergraduateStudent) << endl;
+}
+
+// Loads the same university twice: through the copying value API and through
+// the registry. Allocation counts need -DCOUNT_ALLOCATIONS.
+void benchmarkRegistry(int departmentCount, int coursesPerDepartment, int studentsPerCourse) {
+    vector<unique_ptr<UndergraduateStudent>> people;
+    for (int i = 0; i < studentsPerCourse; ++i)
+        people.emplace_back(new UndergraduateStudent("Student", 20, "S" + to_string(i), "s@email.com", "2022", "CS", 3.0, "CS", "None", "2026"));
+
+    size_t before = allocationsSoFar();
+    auto start = chrono::steady_clock::now();
+    {
+        University uni;
+        for (int d = 0; d < departmentCount; ++d) {
+            Department dept("Department " + to_string(d));
+            for (int c = 0; c < coursesPerDepartment; ++c) {
+                Course course("C" + to_string(d * coursesPerDepartment + c), "A course title long enough to allocate", 3,
+                              "A description that is long enough to live on the heap");
+                for (auto& p : people) course.enrollStudent(p.get());
+                dept.addCourse(static_cast<const Course&>(course));
+            }
+            uni.addDepartment(static_cast<const Department&>(dept));
+        }
+    }
+    double copySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t copyAllocations = allocationsSoFar() - before;
+
+    before = allocationsSoFar();
+    start = chrono::steady_clock::now();
+    {
+        UniversityRegistry registry;
+        for (int d = 0; d < departmentCount; ++d) {
+            Handle<Department> dept = registry.emplace<Department>("Department " + to_string(d));
+            for (int c = 0; c < coursesPerDepartment; ++c) {
+                Course course("C" + to_string(d * coursesPerDepartment + c), "A course title long enough to allocate", 3,
+                              "A description that is long enough to live on the heap");
+                for (auto& p : people) course.enrollStudent(p.get());
+                registry[dept].addCourse(move(course));
+            }
+        }
+        registry.clear();
+    }
+    double registrySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t registryAllocations = allocationsSoFar() - before;
+
+    cout << "registry departments=" << departmentCount << " courses=" << departmentCount * coursesPerDepartment
+         << " copy=" << copySeconds * 1e3 << "ms/" << copyAllocations << " allocs"
+         << " registry=" << registrySeconds * 1e3 << "ms/" << registryAllocations << " allocs" << endl;
+}
+
+// Cold start from a snapshot versus rebuilding the same state in code.
+void benchmarkSnapshot(size_t studentCount) {
+    const string path = "bench_snapshot.bin";
+    auto start = chrono::steady_clock::now();
+    UniversityRegistry registry;
+    GradeBook gradeBook;
+    EnrollmentManager enrollment;
+    Schedule sched;
+    Handle<Department> dept = registry.emplace<Department>("Computer Science");
+    for (int c = 0; c < 100; ++c) {
+        string code = "CS" + to_string(100 + c);
+        registry[dept].addCourse(Course(code, "Course " + code, 3, "Generated course"));
+        sched.addSchedule(code, "Mon 10:00", "R" + to_string(c));
+    }
+    for (size_t i = 0; i < studentCount; ++i) {
+        string id = "S" + to_string(1000000 + i);
+        registry.emplace<UndergraduateStudent>("Student", 20, id, "s@email.com", "2022", "CS", 3.0, "CS", "None", "2026");
+        gradeBook.addGrade(id, static_cast<double>(i % 101));
+        enrollment.enrollStudent("CS" + to_string(100 + i % 100), id);
+    }
+    double rebuildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    bool written = SnapshotWriter().write(path, registry, gradeBook, enrollment, sched);
+    double writeSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    Snapshot fast;
+    bool opened = fast.open(path, false);
+    const PersonRecord* probe = opened ? fast.findPerson("S" + to_string(1000000 + studentCount / 2)) : nullptr;
+    double openSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    Snapshot verified;
+    bool checked = verified.open(path, true);
+    double verifySeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "snapshot students=" << studentCount << " rebuild=" << rebuildSeconds * 1e3 << "ms write="
+         << writeSeconds * 1e3 << "ms open+lookup=" << openSeconds * 1e3 << "ms open+checksum=" << verifySeconds * 1e3
+         << "ms ok=" << (written && opened && checked && probe ? "yes" : "no") << endl;
+    remove(path.c_str());
+}
+
+// Synthetic term: ~5k sections, a few hundred rooms, 30k students taking five courses each.
+void benchmarkRoomSolver(size_t sectionCount, chrono::milliseconds budget) {
+    vector<Classroom> classrooms;
+    for (int r = 0; r < 400; ++r) classrooms.emplace_back("R" + to_string(r), 30 + (r % 5) * 20);
+    vector<string> patterns;
+    const char* dayPairs[] = { "Mon/Wed", "Tue/Thu", "Fri", "Mon/Wed/Fri" };
+    for (const char* days : dayPairs)
+        for (int hour = 8; hour < 18; hour += 2)
+            patterns.push_back(string(days) + " " + (hour < 10 ? "0" : "") + to_string(hour) + ":00-" +
+                               (hour + 1 < 10 ? "0" : "") + to_string(hour + 1) + ":30");
+
+    mt19937 rng(7);
+    vector<SectionRequest> sections(sectionCount);
+    for (size_t i = 0; i < sectionCount; ++i) {
+        sections[i].course = intern("SEC" + to_string(i));
+        sections[i].instructor = intern("PROF" + to_string(i / 3));
+    }
+    for (int student = 0; student < 30000; ++student) {
+        Symbol id = intern("ST" + to_string(student));
+        for (int k = 0; k < 5; ++k) sections[rng() % sectionCount].students.push_back(id);
+    }
+    for (auto& s : sections) {
+        sort(s.students.begin(), s.students.end());
+        s.students.erase(unique(s.students.begin(), s.students.end()), s.students.end());
+    }
+
+    RoomAssignmentSolver solver(move(sections), classrooms, patterns);
+    SolverOptions options;
+    options.budget = budget;
+    auto start = chrono::steady_clock::now();
+    RoomAssignmentSolver::Solution solution = solver.solve(options);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "solver sections=" << sectionCount << " unassigned=" << solution.unassigned << " studentConflicts="
+         << solution.studentConflicts << " wastedSeats=" << solution.wastedSeats << " restarts=" << solution.restarts
+         << " ms=" << seconds * 1e3 << endl;
+}
+
+// Dumps a 1M-person roster through displayDetails() into an ostream and
+// through ReportWriter in each format straight to a file descriptor.
+void benchmarkReports(size_t rosterSize) {
+    vector<unique_ptr<Person>> people;
+    people.reserve(rosterSize);
+    const char* depts[] = { "CS", "Physics", "Math", "Biology" };
+    for (size_t i = 0; i < rosterSize; ++i) {
+        string id = to_string(i), dept = depts[i % 4];
+        switch (i % 5) {
+            case 0: people.emplace_back(new UndergraduateStudent("Student " + id, 20, "U" + id, "u" + id + "@email.com", "2022", dept, 2.0 + (i % 21) / 10.0, dept, "None", "2026")); break;
+            case 1: people.emplace_back(new GraduateStudent("Student " + id, 25, "G" + id, "g" + id + "@email.com", "2021", dept, 3.5, "Topic, \"quoted\"", "Advisor", "Thesis")); break;
+            case 2: people.emplace_back(new AssistantProfessor("Prof " + id, 35, "A" + id, "a" + id + "@email.com", dept, "Spec", "2018")); break;
+            case 3: people.emplace_back(new AssociateProfessor("Prof " + id, 45, "B" + id, "b" + id + "@email.com", dept, "Spec", "2010")); break;
+            default: people.emplace_back(new FullProfessor("Prof " + id, 55, "F" + id, "f" + id + "@email.com", dept, "Spec", "2000"));
+        }
+    }
+
+    auto fileSize = [](const char* path) {
+        struct stat st;
+        return stat(path, &st) == 0 ? static_cast<double>(st.st_size) / (1024 * 1024) : 0.0;
+    };
+
+    const char* streamPath = "bench_report_stream.txt";
+    auto start = chrono::steady_clock::now();
+    {
+        ofstream file(streamPath);
+        streambuf* saved = cout.rdbuf(file.rdbuf());
+        for (const auto& p : people) p->displayDetails();
+        cout.rdbuf(saved);
+    }
+    double streamSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "report n=" << rosterSize << " displayDetails/ostream=" << streamSeconds * 1e3 << "ms ("
+         << fileSize(streamPath) << "MiB)";
+
+    const pair<ReportFormat, const char*> formats[] = { { ReportFormat::Text, "bench_report.txt" },
+                                                        { ReportFormat::Csv, "bench_report.csv" },
+                                                        { ReportFormat::Json, "bench_report.json" } };
+    const char* names[] = { "text", "csv", "json" };
+    for (const auto& format : formats) {
+        start = chrono::steady_clock::now();
+        int fd = open(format.second, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool ok = false;
+        {
+            ReportBuffer buffer(fd);
+            ReportWriter writer(buffer, format.first);
+            writer.begin();
+            for (const auto& p : people) writer.add(*p);
+            ok = writer.end();
+        }
+        close(fd);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << " " << names[static_cast<size_t>(format.first)] << "=" << seconds * 1e3 << "ms ("
+             << fileSize(format.second) << "MiB" << (ok ? "" : ", write failed") << ")";
+    }
+    cout << endl;
+}
+
+// Scans that read only hot fields: mean GPA over graduate students and total
+// credit hours over courses, both stored by value. No hardware counters here,
+// so cache traffic is reported as the 64-byte lines the scan streams through.
+void benchmarkHotScan(size_t studentCount, size_t courseCount, int passes) {
+    vector<GraduateStudent> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        string id = to_string(i);
+        students.emplace_back("Student " + id, 25, "G" + id, "g" + id + "@email.com", "2021", "Physics",
+                              2.0 + (i % 21) / 10.0, "Research topic " + id, "Advisor", "Thesis title " + id);
+    }
+    vector<Course> courses;
+    courses.reserve(courseCount);
+    for (size_t i = 0; i < courseCount; ++i)
+        courses.emplace_back("C" + to_string(i), "Course title", 1 + static_cast<int>(i % 5), "A course description long enough to spill");
+
+    auto start = chrono::steady_clock::now();
+    double gpaSum = 0.0;
+    for (int pass = 0; pass < passes; ++pass)
+        for (const auto& s : students) gpaSum += s.getGPA();
+    double gpaMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / passes;
+
+    start = chrono::steady_clock::now();
+    long long credits = 0;
+    for (int pass = 0; pass < passes; ++pass)
+        for (const auto& c : courses) credits += c.getCredits();
+    double creditMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / passes;
+
+    cout << "hot scan students=" << studentCount << " sizeof(GraduateStudent)=" << sizeof(GraduateStudent)
+         << " lines=" << sizeof(GraduateStudent) * studentCount / 64 << " gpa=" << gpaMs << "ms (mean "
+         << gpaSum / (static_cast<double>(studentCount) * passes) << ")"
+         << " courses=" << courseCount << " sizeof(Course)=" << sizeof(Course)
+         << " lines=" << sizeof(Course) * courseCount / 64 << " credits=" << creditMs << "ms (total "
+         << credits / passes << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchmarkPayroll(10000000);
+        benchmarkSymbolFootprint(1000000);
+        benchmarkRegistry(200, 25, 40);
+        benchmarkSnapshot(1000000);
+        benchmarkRoomSolver(5000, chrono::milliseconds(3000));
+        benchmarkReports(1000000);
+        benchmarkHotScan(2000000, 2000000, 10);
+        return 0;
+    }
 
-int main() {
     UndergraduateStudent u("Alice", 20, "S123", "alice@email.com", "2022", "CS", 3.5, "CS", "Math", "2025");
     GraduateStudent g("Bob", 25, "S124", "bob@email.com", "2021", "Physics", 3.8, "Quantum", "Dr. Smith", "Dark Matter");
 
@@ -245,6 +2396,85 @@ int main() {
     University uni;
     uni.addDepartment(d);
 
+    UniversityRegistry registry;
+    Handle<AssociateProfessor> lee = registry.emplace<AssociateProfessor>("Dr. Lee", 50, "P124", "lee@email.com", "CS", "AI", "2005");
+    Handle<Course> algorithms = registry.add(Course("CS201", "Algorithms", 4, "Design and analysis"));
+    registry[algorithms].setInstructor(&registry[lee]);
+    registry[algorithms].enrollStudent(&u);
+    cout << "Registry courses: " << registry.count<Course>() << ", first: " << registry[algorithms].getCode() << endl;
+
+    GradeBook gb;
+    gb.addGrade("P124", 0);
+    EnrollmentManager em;
+    em.enrollStudent("CS201", "S123");
+    Schedule sched;
+    sched.addSchedule("CS201", "Tue 10:00", "B12");
+    if (SnapshotWriter().write("university.snapshot", registry, gb, em, sched)) {
+        Snapshot snap;
+        if (snap.open("university.snapshot")) {
+            const PersonRecord* found = snap.findPerson("P124");
+            cout << "Snapshot lookup P124: " << (found ? string(snap.text(found->name)) : "missing")
+                 << ", courses: " << snap.count(SectionCourses) << endl;
+        } else {
+            cout << "Snapshot error: " << snap.error() << endl;
+        }
+        remove("university.snapshot");
+    }
+
+    ScheduleEngine engine;
+    engine.addRoom(Classroom("B12", 40));
+    engine.addRoom(Classroom("A1", 120));
+    engine.addRoom(Classroom("C3", 25));
+    engine.book("CS101", "A1", "P123", "Tue/Thu 10:00-11:30");
+    if (engine.book("CS201", "A1", "P124", "Tue 11:00-12:00") == ScheduleConflict::RoomBusy)
+        cout << "CS201 clashes with CS101 in A1" << endl;
+    for (uint32_t room : engine.freeRooms("Tue 10:00", 30))
+        cout << "Free at Tue 10:00 (>=30 seats): " << engine.roomNumber(room) << endl;
+
+    Course physics("PHYS110", "Mechanics", 4, "Classical mechanics");
+    physics.setInstructor(&ap);
+    physics.enrollStudent(&u);
+    physics.enrollStudent(&g);
+    vector<const Course*> term = { &c, &registry[algorithms], &physics };
+    vector<Classroom> classrooms = { Classroom("B12", 40), Classroom("A1", 120) };
+    RoomAssignmentSolver solver(RoomAssignmentSolver::sectionsFrom(term, em), classrooms,
+                                { "Mon/Wed 09:00-10:30", "Tue/Thu 09:00-10:30" });
+    SolverOptions solverOptions;
+    solverOptions.budget = chrono::milliseconds(20);
+    RoomAssignmentSolver::Solution plan = solver.solve(solverOptions);
+    for (size_t i = 0; i < term.size(); ++i)
+        if (plan.placements[i].pattern >= 0)
+            cout << term[i]->getCode() << " -> " << solver.roomNumber(plan.placements[i]) << " "
+                 << solver.patternName(plan.placements[i]) << endl;
+    for (const auto& failure : solver.applyTo(plan, engine))
+        cout << "Could not book " << term[failure.section]->getCode() << ": "
+             << (failure.conflict == ScheduleConflict::RoomBusy ? "room busy" : "instructor busy") << endl;
+
+    ReportBuffer report;
+    ReportWriter json(report, ReportFormat::Json);
+    json.begin();
+    json.add(d);
+    json.add(registry[algorithms]);
+    json.end();
+    ReportWriter csv(report, ReportFormat::Csv);
+    csv.add(u);
+    csv.add(g);
+    cout << report.str();
+
+    PeopleIndex peopleIndex;
+    for (const Person* p : vector<const Person*>{ &u, &g, &ap, &registry[lee] }) peopleIndex.add(p);
+    for (PersonHandle h : peopleIndex.run(PersonQuery().program("CS").gpaBetween(3.5, 4.0)))
+        cout << "CS student with GPA >= 3.5: " << peopleIndex.person(h).getID() << endl;
+    for (PersonHandle h : peopleIndex.run(PersonQuery().type(PersonType::AssociateProf).department("CS")))
+        cout << "Associate professor in CS: " << peopleIndex.person(h).getID() << endl;
+
+    PayrollRoster payroll;
+    vector<Person*> staff = { &u, &g, &ap };
+    for (Person* p : staff) payroll.add(p);
+    PayrollReport pay = payroll.compute();
+    cout << "Payroll total: $" << pay.total << ", Assistant Professors: $"
+         << pay.byType[static_cast<size_t>(PersonType::AssistantProf)] << endl;
+
     cout << "University System Initialized." << endl;
 
     return 0;
@@ -6,7 +6,31 @@
 #include <memory>
 #include <algorithm>
 #include <stdexcept>
+#include <exception>
 #include <fstream>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <chrono>
+#include <queue>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <condition_variable>
+#include <climits>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <string_view>
+#include <charconv>
+#include <unordered_map>
+#include <unordered_set>
+#include <random>
+#include <deque>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
 using namespace std;
 
 
@@ -34,12 +58,288 @@ public:
     PaymentException(const string& msg) : UniversitySystemException("Payment Error: " + msg) {}
 };
 
+class PrerequisiteException : public UniversitySystemException {
+public:
+    PrerequisiteException(const string& msg) : UniversitySystemException("Prerequisite Error: " + msg) {}
+};
+
+struct ErrorLoggerConfig {
+    string path = "errors.log";
+    size_t capacity = 4096;                  // ring slots, rounded up to a power of two
+    chrono::milliseconds flushInterval{50};
+};
+
+// Asynchronous error log. Producers copy the message into a bounded
+// multi-producer ring (Vyukov sequence slots) and return; a background thread
+// drains ready slots in batches with a single writev per batch. When the ring
+// is full new messages are dropped and counted rather than blocking.
+class ErrorLogger {
+private:
+    static const size_t SlotText = 256;
+
+    struct Slot {
+        atomic<size_t> sequence;
+        size_t length;
+        char text[SlotText];
+    };
+
+    ErrorLoggerConfig config;
+    size_t mask;
+    unique_ptr<Slot[]> slots;
+    atomic<size_t> head{0};   // next slot producers claim
+    size_t tail = 0;          // next slot the writer drains (writer thread only)
+    atomic<size_t> drained{0};
+
+    atomic<uint64_t> logged{0}, dropped{0}, truncated{0}, batches{0}, writeErrors{0};
+
+    int fd;
+    atomic<bool> stopping{false};
+    mutex wakeMutex;
+    condition_variable wake;
+    thread writer;
+
+    size_t drainOnce() {
+        const size_t maxBatch = IOV_MAX < 1024 ? IOV_MAX : 1024;
+        iovec iov[1024];
+        size_t count = 0;
+        while (count < maxBatch) {
+            Slot& slot = slots[(tail + count) & mask];
+            if (slot.sequence.load(memory_order_acquire) != tail + count + 1) break;
+            iov[count].iov_base = slot.text;
+            iov[count].iov_len = slot.length;
+            ++count;
+        }
+        if (count == 0) return 0;
+
+        iovec* pending = iov;
+        int remaining = static_cast<int>(count);
+        if (fd < 0) writeErrors.fetch_add(1, memory_order_relaxed); // log file never opened; batch is lost
+        while (fd >= 0 && remaining > 0) {
+            ssize_t written = writev(fd, pending, remaining);
+            if (written < 0 && errno == EINTR) continue;
+            if (written < 0) {
+                writeErrors.fetch_add(1, memory_order_relaxed);
+                break;
+            }
+            while (remaining > 0 && static_cast<size_t>(written) >= pending->iov_len) {
+                written -= pending->iov_len;
+                ++pending;
+                --remaining;
+            }
+            if (remaining > 0) {
+                pending->iov_base = static_cast<char*>(pending->iov_base) + written;
+                pending->iov_len -= written;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            slots[(tail + i) & mask].sequence.store(tail + i + mask + 1, memory_order_release);
+        tail += count;
+        drained.store(tail, memory_order_release);
+        batches.fetch_add(1, memory_order_relaxed);
+        return count;
+    }
+
+    void run() {
+        while (!stopping.load(memory_order_acquire)) {
+            while (drainOnce() != 0) {}
+            unique_lock<mutex> lock(wakeMutex);
+            wake.wait_for(lock, config.flushInterval);
+        }
+        while (drainOnce() != 0) {}
+    }
+
+public:
+    explicit ErrorLogger(const ErrorLoggerConfig& cfg = ErrorLoggerConfig()) : config(cfg) {
+        size_t capacity = 2;
+        while (capacity < config.capacity) capacity <<= 1;
+        mask = capacity - 1;
+        slots.reset(new Slot[capacity]);
+        for (size_t i = 0; i < capacity; ++i) slots[i].sequence.store(i, memory_order_relaxed);
+        fd = open(config.path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        writer = thread(&ErrorLogger::run, this);
+    }
+
+    ~ErrorLogger() {
+        stopping.store(true, memory_order_release);
+        wake.notify_one();
+        writer.join();
+        if (fd >= 0) close(fd);
+    }
+
+    ErrorLogger(const ErrorLogger&) = delete;
+    ErrorLogger& operator=(const ErrorLogger&) = delete;
+
+    // Lock-free; returns false if the message was dropped because the ring is full.
+    bool log(const char* message, size_t length) {
+        size_t pos = head.load(memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, memory_order_relaxed);
+                return false;
+            } else {
+                pos = head.load(memory_order_relaxed);
+            }
+        }
+        if (length > SlotText - 1) {
+            length = SlotText - 1;
+            truncated.fetch_add(1, memory_order_relaxed);
+        }
+        memcpy(slot->text, message, length);
+        slot->text[length] = '\n';
+        slot->length = length + 1;
+        slot->sequence.store(pos + 1, memory_order_release);
+        logged.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+
+    bool log(const string& message) { return log(message.data(), message.size()); }
+
+    // Blocks until everything logged before the call has been written.
+    void flush() {
+        size_t target = head.load(memory_order_acquire);
+        while (drained.load(memory_order_acquire) < target) {
+            wake.notify_one();
+            this_thread::sleep_for(chrono::microseconds(100));
+        }
+    }
+
+    uint64_t getLoggedCount() const { return logged.load(memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return dropped.load(memory_order_relaxed); }
+    uint64_t getTruncatedCount() const { return truncated.load(memory_order_relaxed); }
+    uint64_t getBatchCount() const { return batches.load(memory_order_relaxed); }
+    uint64_t getWriteErrorCount() const { return writeErrors.load(memory_order_relaxed); }
+};
+
+// Deliberately leaked so logError() stays usable from static destructors that
+// run after this function's first caller; an exit handler flushes what was
+// logged up to that point.
+ErrorLogger& errorLogger() {
+    static ErrorLogger* logger = [] {
+        ErrorLogger* created = new ErrorLogger();
+        atexit([] { errorLogger().flush(); });
+        return created;
+    }();
+    return *logger;
+}
+
 void logError(const string& error) {
-    ofstream log("errors.log", ios::app);
-    log << error << endl;
-    log.close();
+    errorLogger().log(error);
 }
 
+// ===================== Batch Results =====================
+
+// Row-level validation outcome for the non-throwing bulk APIs.
+enum class ErrorCode : uint8_t {
+    None,
+    InvalidID,
+    InvalidContact,
+    InvalidGrade,
+    InvalidCourseCode,
+    InvalidStudentID,
+    InvalidAge,
+    InvalidGPA,
+    MalformedRecord,
+    UnknownRecordType,
+    LineTooLong,
+    Count
+};
+
+const char* errorCodeName(ErrorCode code) {
+    switch (code) {
+        case ErrorCode::None: return "None";
+        case ErrorCode::InvalidID: return "InvalidID";
+        case ErrorCode::InvalidContact: return "InvalidContact";
+        case ErrorCode::InvalidGrade: return "InvalidGrade";
+        case ErrorCode::InvalidCourseCode: return "InvalidCourseCode";
+        case ErrorCode::InvalidStudentID: return "InvalidStudentID";
+        case ErrorCode::InvalidAge: return "InvalidAge";
+        case ErrorCode::InvalidGPA: return "InvalidGPA";
+        case ErrorCode::MalformedRecord: return "MalformedRecord";
+        case ErrorCode::UnknownRecordType: return "UnknownRecordType";
+        case ErrorCode::LineTooLong: return "LineTooLong";
+        default: return "Unknown";
+    }
+}
+
+// Either a value or an ErrorCode, never both.
+template <typename T>
+class Expected {
+private:
+    T val;
+    ErrorCode code;
+
+public:
+    Expected(T value) : val(move(value)), code(ErrorCode::None) {}
+    Expected(ErrorCode error) : val(), code(error) {}
+
+    bool ok() const { return code == ErrorCode::None; }
+    ErrorCode error() const { return code; }
+    T& value() { return val; }
+    const T& value() const { return val; }
+};
+
+template <>
+class Expected<void> {
+private:
+    ErrorCode code;
+
+public:
+    Expected(ErrorCode error = ErrorCode::None) : code(error) {}
+    bool ok() const { return code == ErrorCode::None; }
+    ErrorCode error() const { return code; }
+};
+
+struct BatchError {
+    size_t row;
+    ErrorCode code;
+};
+
+struct BatchReport {
+    size_t total = 0;
+    size_t succeeded = 0;
+    size_t countByCode[static_cast<size_t>(ErrorCode::Count)] = {};
+    vector<BatchError> errors; // failing rows only, in row order
+
+    size_t failed() const { return total - succeeded; }
+
+    void record(size_t row, ErrorCode code) {
+        ++total;
+        if (code == ErrorCode::None) {
+            ++succeeded;
+            return;
+        }
+        ++countByCode[static_cast<size_t>(code)];
+        errors.push_back(BatchError{row, code});
+    }
+
+    void merge(const BatchReport& other) {
+        total += other.total;
+        succeeded += other.succeeded;
+        for (size_t c = 0; c < static_cast<size_t>(ErrorCode::Count); ++c) countByCode[c] += other.countByCode[c];
+        errors.insert(errors.end(), other.errors.begin(), other.errors.end());
+    }
+
+    void print(ostream& out) const {
+        out << "Batch: " << succeeded << "/" << total << " ok";
+        for (size_t c = 1; c < static_cast<size_t>(ErrorCode::Count); ++c)
+            if (countByCode[c]) out << ", " << errorCodeName(static_cast<ErrorCode>(c)) << "=" << countByCode[c];
+        out << "\n";
+    }
+};
+
+template <typename T>
+struct BatchResult {
+    vector<Expected<T>> rows;
+    BatchReport report;
+};
+
 
 class Person {
 protected:
@@ -51,10 +351,28 @@ protected:
 public:
     Person(string name, int age, string ID, string contact)
         : name(name), age(age), ID(ID), contact(contact) {
-        if (ID.empty()) throw UniversitySystemException("Invalid ID provided");
-        if (contact.find('@') == string::npos) throw UniversitySystemException("Invalid contact info");
+        ErrorCode code = validate(ID, contact);
+        if (code == ErrorCode::InvalidID) throw UniversitySystemException("Invalid ID provided");
+        if (code == ErrorCode::InvalidContact) throw UniversitySystemException("Invalid contact info");
     }
 
+    static ErrorCode validate(const string& ID, const string& contact) {
+        if (ID.empty()) return ErrorCode::InvalidID;
+        if (contact.find('@') == string::npos) return ErrorCode::InvalidContact;
+        return ErrorCode::None;
+    }
+
+    Person(const Person&) = default;
+    Person& operator=(const Person&) = default;
+    // TypedRoster keeps leaves by value and moves them when its vectors grow;
+    // the virtual destructor stops the compiler from declaring these itself.
+    Person(Person&&) = default;
+    Person& operator=(Person&&) = default;
+
+    const string& getID() const { return ID; }
+    const string& getContact() const { return contact; }
+    int getAge() const { return age; }
+
     virtual void displayDetails() const {
         cout << "Name: " << name << ", Age: " << age << ", ID: " << ID << ", Contact: " << contact << endl;
     }
@@ -74,6 +392,9 @@ public:
             string enrollmentDate, string program, double GPA)
         : Person(name, age, ID, contact), enrollmentDate(enrollmentDate), program(program), GPA(GPA) {}
 
+    double getGPA() const { return GPA; }
+    void setGPA(double value) { GPA = value; }
+
     void displayDetails() const override {
         Person::displayDetails();
         cout << "Program: " << program << ", GPA: " << GPA << endl;
@@ -85,7 +406,7 @@ public:
     }
 };
 
-class UndergraduateStudent : public Student {
+class UndergraduateStudent final : public Student {
 private:
     string major, minor, expectedGraduation;
 
@@ -106,7 +427,7 @@ public:
     }
 };
 
-class GraduateStudent : public Student {
+class GraduateStudent final : public Student {
 private:
     string researchTopic, advisor, thesisTitle;
 
@@ -148,7 +469,7 @@ public:
     }
 };
 
-class AssistantProfessor : public Professor {
+class AssistantProfessor final : public Professor {
 public:
     AssistantProfessor(string name, int age, string ID, string contact,
                        string department, string specialization, string hireDate)
@@ -159,7 +480,7 @@ public:
     }
 };
 
-class AssociateProfessor : public Professor {
+class AssociateProfessor final : public Professor {
 public:
     AssociateProfessor(string name, int age, string ID, string contact,
                        string department, string specialization, string hireDate)
@@ -170,7 +491,7 @@ public:
     }
 };
 
-class FullProfessor : public Professor {
+class FullProfessor final : public Professor {
 public:
     FullProfessor(string name, int age, string ID, string contact,
                   string department, string specialization, string hireDate)
@@ -181,6 +502,173 @@ public:
     }
 };
 
+// Bulk creation without exceptions: each row holds the constructor arguments
+// (name, age, ID, contact, ...) and is validated before anything is built.
+template <typename T, typename... Args>
+BatchResult<unique_ptr<T>> createPeople(const vector<tuple<Args...>>& rows) {
+    BatchResult<unique_ptr<T>> result;
+    result.rows.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ErrorCode code = Person::validate(get<2>(rows[i]), get<3>(rows[i]));
+        result.report.record(i, code);
+        if (code != ErrorCode::None) {
+            result.rows.emplace_back(code);
+            continue;
+        }
+        result.rows.emplace_back(apply([](const Args&... args) { return unique_ptr<T>(new T(args...)); }, rows[i]));
+    }
+    return result;
+}
+
+// ===================== Prerequisite Graph =====================
+
+// Dense process-wide numbering of course codes, so sets of courses can be
+// bitsets. Indices are never reused.
+class CourseIndex {
+private:
+    mutable mutex indexMutex;
+    unordered_map<string, uint32_t> ids;
+    deque<string> codes;
+
+public:
+    uint32_t intern(const string& code) {
+        lock_guard<mutex> lock(indexMutex);
+        auto inserted = ids.emplace(code, static_cast<uint32_t>(codes.size()));
+        if (inserted.second) codes.push_back(code);
+        return inserted.first->second;
+    }
+
+    // Lookup without registering; false for codes never interned.
+    bool find(const string& code, uint32_t& index) const {
+        lock_guard<mutex> lock(indexMutex);
+        auto it = ids.find(code);
+        if (it == ids.end()) return false;
+        index = it->second;
+        return true;
+    }
+
+    const string& code(uint32_t index) const {
+        lock_guard<mutex> lock(indexMutex);
+        return codes[index];
+    }
+};
+
+CourseIndex& courseIndex() {
+    static CourseIndex index;
+    return index;
+}
+
+// Growable bitset over course indices; bits past the end read as clear.
+class CourseSet {
+private:
+    vector<uint64_t> words;
+
+public:
+    void set(uint32_t index) {
+        if (index / 64 >= words.size()) words.resize(index / 64 + 1, 0);
+        words[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    void reset(uint32_t index) {
+        if (index / 64 < words.size()) words[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    bool test(uint32_t index) const {
+        return index / 64 < words.size() && (words[index / 64] >> (index % 64) & 1);
+    }
+
+    void merge(const CourseSet& other) {
+        if (other.words.size() > words.size()) words.resize(other.words.size(), 0);
+        for (size_t i = 0; i < other.words.size(); ++i) words[i] |= other.words[i];
+    }
+
+    // True when every course in required is also in this set.
+    bool containsAll(const CourseSet& required) const {
+        size_t shared = min(words.size(), required.words.size());
+        for (size_t i = 0; i < shared; ++i)
+            if (required.words[i] & ~words[i]) return false;
+        for (size_t i = shared; i < required.words.size(); ++i)
+            if (required.words[i]) return false;
+        return true;
+    }
+
+    // Courses in required that are missing from this set, in index order.
+    vector<uint32_t> missingFrom(const CourseSet& required) const {
+        vector<uint32_t> missing;
+        for (size_t i = 0; i < required.words.size(); ++i) {
+            uint64_t word = required.words[i] & ~(i < words.size() ? words[i] : 0);
+            for (; word; word &= word - 1)
+                missing.push_back(static_cast<uint32_t>(i * 64 + __builtin_ctzll(word)));
+        }
+        return missing;
+    }
+};
+
+// Prerequisite DAG over courses. For every course it keeps the transitive
+// closure of its prerequisites as a CourseSet, so an eligibility check is a
+// containsAll() against the student's completed courses. Adding an edge
+// rejects cycles with one bit test, then ORs the new prerequisites into every
+// course that already depends on the target: O(courses * words) per edge.
+// Build the graph before enrollment opens; it is not safe to add edges while
+// other threads check eligibility.
+class PrerequisiteGraph {
+private:
+    vector<CourseSet> closure; // by course index; transitive prerequisites
+
+    void grow(uint32_t index) {
+        if (index >= closure.size()) closure.resize(index + 1);
+    }
+
+public:
+    // Records that course requires prerequisite. Returns false if the edge is
+    // already implied; throws if it would close a cycle.
+    bool addPrerequisite(const string& courseCode, const string& prerequisiteCode) {
+        uint32_t course = courseIndex().intern(courseCode);
+        uint32_t prerequisite = courseIndex().intern(prerequisiteCode);
+        grow(max(course, prerequisite));
+        if (course == prerequisite || closure[prerequisite].test(course))
+            throw PrerequisiteException("Cycle: " + prerequisiteCode + " already requires " + courseCode);
+        if (closure[course].test(prerequisite)) return false;
+
+        CourseSet added = closure[prerequisite];
+        added.set(prerequisite);
+        for (uint32_t dependent = 0; dependent < closure.size(); ++dependent)
+            if (dependent == course || closure[dependent].test(course)) closure[dependent].merge(added);
+        return true;
+    }
+
+    // Every course that must be completed before course; empty if unknown.
+    const CourseSet& requiredFor(uint32_t course) const {
+        static const CourseSet none;
+        return course < closure.size() ? closure[course] : none;
+    }
+
+    bool isPrerequisite(const string& courseCode, const string& prerequisiteCode) const {
+        uint32_t course, prerequisite;
+        return courseIndex().find(courseCode, course) && courseIndex().find(prerequisiteCode, prerequisite)
+            && requiredFor(course).test(prerequisite);
+    }
+};
+
+class GradeBook;
+
+struct WaitlistEntry {
+    int priorityClass;     // higher classes are served first
+    double GPA;
+    uint64_t requestOrder; // arrival sequence within the course
+    Student* student;
+};
+
+// Max-heap order: priority class, then GPA, then earliest request.
+struct WaitlistOrder {
+    bool operator()(const WaitlistEntry& a, const WaitlistEntry& b) const {
+        if (a.priorityClass != b.priorityClass) return a.priorityClass < b.priorityClass;
+        if (a.GPA != b.GPA) return a.GPA < b.GPA;
+        return a.requestOrder > b.requestOrder;
+    }
+};
+
+enum class EnrollStatus { Enrolled, Waitlisted, Ineligible, AlreadyEnrolled, AlreadyWaitlisted };
 
 class Course {
 private:
@@ -188,16 +676,206 @@ private:
     int credits, maxStudents = 30;
     Professor* instructor;
     vector<Student*> students;
+    unordered_map<const Student*, size_t> rosterIndex; // student -> position in students
+
+    // A full course is rejected from seatsTaken alone, without ever taking
+    // rosterMutex; open seats are claimed with a CAS on it.
+    atomic<int> seatsTaken{0};
+    mutable mutex rosterMutex;
+
+    // Guarded by rosterMutex. waiting maps each queued student to the
+    // requestOrder of their live entry; heap entries that no longer match
+    // (the student left or was seated) are skipped when they reach the top.
+    priority_queue<WaitlistEntry, vector<WaitlistEntry>, WaitlistOrder> waitlist;
+    unordered_map<const Student*, uint64_t> waiting;
+    uint64_t nextRequest = 0;
+
+    uint32_t index;                                   // in courseIndex()
+    const PrerequisiteGraph* prerequisites = nullptr; // both unset: no eligibility check
+    const GradeBook* completions = nullptr;
+
+    enum class Claim { Seated, Full, Duplicate };
+
+    // Caller holds rosterMutex for these three.
+    bool enrolledLocked(const Student* student) const { return rosterIndex.count(student) != 0; }
+
+    void seat(Student* student) {
+        rosterIndex.emplace(student, students.size());
+        students.push_back(student);
+    }
+
+    bool unseat(const Student* student) {
+        auto it = rosterIndex.find(student);
+        if (it == rosterIndex.end()) return false;
+        Student* last = students.back();
+        students[it->second] = last;
+        rosterIndex[last] = it->second;
+        students.pop_back();
+        rosterIndex.erase(student);
+        return true;
+    }
+
+    // Caller holds rosterMutex. Pops stale and no-longer-eligible entries;
+    // returns the next student to seat, or nullptr if nobody is waiting.
+    Student* popWaitlisted() {
+        while (!waitlist.empty()) {
+            WaitlistEntry head = waitlist.top();
+            waitlist.pop();
+            auto it = waiting.find(head.student);
+            if (it == waiting.end() || it->second != head.requestOrder) continue;
+            waiting.erase(it);
+            if (isEligible(head.student)) return head.student;
+        }
+        return nullptr;
+    }
+
+    // Caller holds rosterMutex. Gives a seat the caller already holds to the
+    // head of the waitlist without ever making it visible to tryReserveSeat(),
+    // so a concurrent newcomer cannot overtake the queue; frees it otherwise.
+    void releaseSeat() {
+        if (Student* next = popWaitlisted()) seat(next);
+        else seatsTaken.fetch_sub(1, memory_order_acq_rel);
+    }
+
+    // Caller holds rosterMutex. Fills seats freed before a request was queued.
+    void promoteWaitlisted() {
+        while (!waitlist.empty() && tryReserveSeat()) {
+            Student* next = popWaitlisted();
+            if (!next) {
+                seatsTaken.fetch_sub(1, memory_order_acq_rel);
+                break;
+            }
+            seat(next);
+        }
+    }
+
+    // Prerequisites already checked by the caller. The duplicate check comes
+    // before the reservation, so a repeated request never holds a seat that
+    // a concurrent first-time request could have had.
+    Claim claimSeat(Student* student) {
+        if (isFull()) return Claim::Full;
+        lock_guard<mutex> lock(rosterMutex);
+        if (enrolledLocked(student)) return Claim::Duplicate;
+        if (!tryReserveSeat()) return Claim::Full;
+        seat(student);
+        waiting.erase(student); // seated directly; its heap entry goes stale
+        return Claim::Seated;
+    }
 
 public:
     Course(string code, string title, int credits, string description)
-        : code(code), title(title), credits(credits), description(description), instructor(nullptr) {}
+        : code(code), title(title), description(description), credits(credits), instructor(nullptr),
+          index(courseIndex().intern(code)) {}
+
+    Course(const Course& other)
+        : code(other.code), title(other.title), description(other.description),
+          credits(other.credits), maxStudents(other.maxStudents), instructor(other.instructor),
+          index(other.index), prerequisites(other.prerequisites), completions(other.completions) {
+        lock_guard<mutex> lock(other.rosterMutex);
+        students = other.students;
+        rosterIndex = other.rosterIndex;
+        waitlist = other.waitlist;
+        waiting = other.waiting;
+        nextRequest = other.nextRequest;
+        seatsTaken.store(static_cast<int>(students.size()), memory_order_relaxed);
+    }
+
+    Course& operator=(const Course&) = delete;
 
     void setInstructor(Professor* prof) { instructor = prof; }
+    void setMaxStudents(int limit) { maxStudents = limit; }
+    int getEnrolledCount() const { return seatsTaken.load(memory_order_acquire); }
+    const string& getCode() const { return code; }
+    int getCredits() const { return credits; }
+    uint32_t getIndex() const { return index; }
+
+    // Every enrollment path rejects students whose completed courses in
+    // grades do not cover every transitive prerequisite in graph.
+    void setPrerequisiteCheck(const PrerequisiteGraph* graph, const GradeBook* grades) {
+        prerequisites = graph;
+        completions = grades;
+    }
+
+    bool isEligible(const Student* student) const;
+    vector<string> missingPrerequisites(const Student* student) const;
+
+    bool isFull() const { return seatsTaken.load(memory_order_acquire) >= maxStudents; }
+
+    bool tryReserveSeat() {
+        int taken = seatsTaken.load(memory_order_relaxed);
+        do {
+            if (taken >= maxStudents) return false;
+        } while (!seatsTaken.compare_exchange_weak(taken, taken + 1, memory_order_acq_rel, memory_order_relaxed));
+        return true;
+    }
+
+    // Thread-safe; returns false when the course is full, the student lacks
+    // prerequisites or is already enrolled.
+    // A full course is rejected before the prerequisite lookup, keeping that
+    // path lock-free.
+    bool tryEnrollStudent(Student* student) {
+        return !isFull() && isEligible(student) && claimSeat(student) == Claim::Seated;
+    }
+
     void enrollStudent(Student* student) {
-        if (students.size() >= maxStudents)
+        if (!isEligible(student)) {
+            string missing;
+            for (const string& course : missingPrerequisites(student)) missing += (missing.empty() ? "" : ", ") + course;
+            throw EnrollmentException(student->getID() + " lacks prerequisites for " + code + ": " + missing);
+        }
+        Claim claim = claimSeat(student);
+        if (claim == Claim::Duplicate)
+            throw EnrollmentException(student->getID() + " is already enrolled in " + code);
+        if (claim == Claim::Full)
             throw EnrollmentException("Course is full: " + code);
-        students.push_back(student);
+    }
+
+    // Never throws: a full course queues the request instead of rejecting it.
+    EnrollStatus enrollOrWaitlist(Student* student, int priorityClass = 0) {
+        if (!isEligible(student)) return EnrollStatus::Ineligible;
+        {
+            lock_guard<mutex> lock(rosterMutex);
+            if (waiting.count(student)) return EnrollStatus::AlreadyWaitlisted;
+        }
+        Claim claim = claimSeat(student);
+        if (claim == Claim::Seated) return EnrollStatus::Enrolled;
+        if (claim == Claim::Duplicate) return EnrollStatus::AlreadyEnrolled;
+        lock_guard<mutex> lock(rosterMutex);
+        if (enrolledLocked(student)) return EnrollStatus::AlreadyEnrolled;
+        if (waiting.count(student)) return EnrollStatus::AlreadyWaitlisted;
+        waiting[student] = nextRequest;
+        waitlist.push(WaitlistEntry{priorityClass, student->getGPA(), nextRequest++, student});
+        promoteWaitlisted(); // a drop may have freed a seat since the failed reservation
+        return enrolledLocked(student) ? EnrollStatus::Enrolled : EnrollStatus::Waitlisted;
+    }
+
+    // Withdraws a pending waitlist request; false if the student was not waiting.
+    bool leaveWaitlist(const Student* student) {
+        lock_guard<mutex> lock(rosterMutex);
+        return waiting.erase(student) != 0;
+    }
+
+    bool isWaitlisted(const Student* student) const {
+        lock_guard<mutex> lock(rosterMutex);
+        return waiting.count(student) != 0;
+    }
+
+    // Frees the student's seat and hands it to the next waitlisted student.
+    bool dropStudent(Student* student) {
+        lock_guard<mutex> lock(rosterMutex);
+        if (!unseat(student)) return false;
+        releaseSeat();
+        return true;
+    }
+
+    bool isEnrolled(const Student* student) const {
+        lock_guard<mutex> lock(rosterMutex);
+        return enrolledLocked(student);
+    }
+
+    size_t getWaitlistSize() const {
+        lock_guard<mutex> lock(rosterMutex);
+        return waiting.size();
     }
 };
 
@@ -247,13 +925,81 @@ class GradeBook {
 private:
     map<string, double> grades; // studentID -> grade
 
+    struct CourseRecord {
+        unordered_map<uint32_t, double> grades; // course index -> final grade
+        CourseSet passed;
+    };
+
+    // Per-course grades are read by Course eligibility checks on enrolling
+    // threads while grading goes on; readers share the lock.
+    mutable shared_mutex courseMutex;
+    unordered_map<string, CourseRecord> courseRecords; // studentID -> course grades
+
 public:
+    static constexpr double PassingGrade = 60.0;
+
+    static ErrorCode validateGrade(double grade) {
+        return (grade >= 0 && grade <= 100) ? ErrorCode::None : ErrorCode::InvalidGrade;
+    }
+
     void addGrade(string studentID, double grade) {
-        if (grade < 0 || grade > 100)
+        if (validateGrade(grade) != ErrorCode::None)
             throw GradeException("Invalid grade entry: " + to_string(grade));
         grades[studentID] = grade;
     }
 
+    // Non-throwing bulk upload; invalid rows are skipped and reported.
+    BatchResult<void> addGrades(const vector<pair<string, double>>& rows) {
+        BatchResult<void> result;
+        result.rows.reserve(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            ErrorCode code = validateGrade(rows[i].second);
+            if (code == ErrorCode::None) grades[rows[i].first] = rows[i].second;
+            result.rows.emplace_back(code);
+            result.report.record(i, code);
+        }
+        return result;
+    }
+
+    // Final grade for one course; a passing grade marks it completed, a
+    // failing regrade clears it again.
+    void addCourseGrade(const string& studentID, const string& courseCode, double grade) {
+        if (validateGrade(grade) != ErrorCode::None)
+            throw GradeException("Invalid grade entry: " + to_string(grade));
+        uint32_t course = courseIndex().intern(courseCode);
+        unique_lock<shared_mutex> lock(courseMutex);
+        CourseRecord& record = courseRecords[studentID];
+        record.grades[course] = grade;
+        if (grade >= PassingGrade) record.passed.set(course);
+        else record.passed.reset(course);
+    }
+
+    // -1 if the student has no grade for the course.
+    double getCourseGrade(const string& studentID, const string& courseCode) const {
+        uint32_t course;
+        if (!courseIndex().find(courseCode, course)) return -1;
+        shared_lock<shared_mutex> lock(courseMutex);
+        auto it = courseRecords.find(studentID);
+        if (it == courseRecords.end()) return -1;
+        auto grade = it->second.grades.find(course);
+        return grade != it->second.grades.end() ? grade->second : -1;
+    }
+
+    // True when the student has passed every course in required.
+    bool hasCompleted(const string& studentID, const CourseSet& required) const {
+        static const CourseSet none;
+        shared_lock<shared_mutex> lock(courseMutex);
+        auto it = courseRecords.find(studentID);
+        return (it != courseRecords.end() ? it->second.passed : none).containsAll(required);
+    }
+
+    vector<uint32_t> missingCourses(const string& studentID, const CourseSet& required) const {
+        static const CourseSet none;
+        shared_lock<shared_mutex> lock(courseMutex);
+        auto it = courseRecords.find(studentID);
+        return (it != courseRecords.end() ? it->second.passed : none).missingFrom(required);
+    }
+
     double calculateAverageGrade() {
         double sum = 0;
         for (auto& g : grades) sum += g.second;
@@ -261,6 +1007,19 @@ public:
     }
 };
 
+bool Course::isEligible(const Student* student) const {
+    if (!prerequisites || !completions) return true;
+    return completions->hasCompleted(student->getID(), prerequisites->requiredFor(index));
+}
+
+vector<string> Course::missingPrerequisites(const Student* student) const {
+    vector<string> missing;
+    if (!prerequisites || !completions) return missing;
+    for (uint32_t course : completions->missingCourses(student->getID(), prerequisites->requiredFor(index)))
+        missing.push_back(courseIndex().code(course));
+    return missing;
+}
+
 class EnrollmentManager {
 private:
     map<string, vector<string>> courseEnrollments; // courseCode -> list of studentIDs
@@ -269,10 +1028,1063 @@ public:
     void enrollStudent(string courseCode, string studentID) {
         courseEnrollments[courseCode].push_back(studentID);
     }
+
+    // Non-throwing bulk enrollment of (courseCode, studentID) rows.
+    BatchResult<void> enrollStudents(const vector<pair<string, string>>& rows) {
+        BatchResult<void> result;
+        result.rows.reserve(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            ErrorCode code = ErrorCode::None;
+            if (rows[i].first.empty()) code = ErrorCode::InvalidCourseCode;
+            else if (rows[i].second.empty()) code = ErrorCode::InvalidStudentID;
+            else courseEnrollments[rows[i].first].push_back(rows[i].second);
+            result.rows.emplace_back(code);
+            result.report.record(i, code);
+        }
+        return result;
+    }
 };
 
+// ===================== Typed Roster =====================
+
+// Stores each concrete person type by value in its own contiguous vector. The
+// leaf classes are final, so the batch operations below call
+// calculatePayment() and displayDetails() on the exact type and the compiler
+// resolves and inlines them instead of dispatching through the vtable.
+// Iteration is grouped by type in the order of the template arguments.
+// References are invalidated when their type's vector grows.
+template <typename... Types>
+class TypedRoster {
+private:
+    tuple<vector<Types>...> lists;
+
+    template <typename Fn, size_t... I>
+    void visit(Fn& fn, index_sequence<I...>) const {
+        (void)initializer_list<int>{ (visitList(get<I>(lists), fn), 0)... };
+    }
+
+    template <typename T, typename Fn>
+    static void visitList(const vector<T>& list, Fn& fn) {
+        for (const T& person : list) fn(person);
+    }
+
+    static ErrorCode check(const Person& p) {
+        if (p.getAge() <= 0 || p.getAge() > 120) return ErrorCode::InvalidAge;
+        return Person::validate(p.getID(), p.getContact());
+    }
+
+    static ErrorCode check(const Student& s) {
+        ErrorCode code = check(static_cast<const Person&>(s));
+        if (code == ErrorCode::None && !(s.getGPA() >= 0.0 && s.getGPA() <= 4.0)) return ErrorCode::InvalidGPA;
+        return code;
+    }
+
+public:
+    template <typename T>
+    T& add(T person) {
+        vector<T>& list = get<vector<T>>(lists);
+        list.push_back(move(person));
+        return list.back();
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        vector<T>& list = get<vector<T>>(lists);
+        list.emplace_back(forward<Args>(args)...);
+        return list.back();
+    }
+
+    template <typename T>
+    const vector<T>& all() const { return get<vector<T>>(lists); }
+
+    template <typename T>
+    void reserve(size_t n) { get<vector<T>>(lists).reserve(n); }
+
+    size_t size() const {
+        size_t total = 0;
+        (void)initializer_list<int>{ (total += get<vector<Types>>(lists).size(), 0)... };
+        return total;
+    }
+
+    // fn is instantiated once per concrete type, e.g. a generic lambda.
+    template <typename Fn>
+    void forEach(Fn fn) const { visit(fn, index_sequence_for<Types...>()); }
+
+    double totalPayment() const {
+        double total = 0.0;
+        forEach([&total](const auto& person) { total += person.calculatePayment(); });
+        return total;
+    }
+
+    void displayAll() const {
+        forEach([](const auto& person) { person.displayDetails(); });
+    }
+
+    // Same rules as the importer: age 1-120, ID present, '@' in contact, GPA 0-4
+    // for students. Rows are numbered in iteration order.
+    BatchReport validate() const {
+        BatchReport report;
+        size_t row = 0;
+        forEach([&report, &row](const auto& person) { report.record(row++, check(person)); });
+        return report;
+    }
+};
+
+typedef TypedRoster<UndergraduateStudent, GraduateStudent, AssistantProfessor, AssociateProfessor, FullProfessor> PersonRoster;
+
+// ===================== Transcript Engine =====================
+
+// Standard 4-point scale for a 0-100 score.
+double gradePoints(double score) {
+    if (score >= 90) return 4.0;
+    if (score >= 80) return 3.0;
+    if (score >= 70) return 2.0;
+    if (score >= 60) return 1.0;
+    return 0.0;
+}
+
+// Per-student, per-course, per-term grades with credit-weighted GPA. Each
+// transcript keeps running quality-point and credit totals (overall and per
+// term), so changing one grade is an O(1) adjustment; recomputeAll() rebuilds
+// every total from the entries in parallel at end of term.
+class TranscriptEngine {
+private:
+    struct Entry {
+        int credits;
+        double score;
+        double points;
+    };
+
+    struct Totals {
+        double qualityPoints = 0.0;
+        int credits = 0;
+
+        void add(const Entry& e, int sign) {
+            qualityPoints += sign * e.credits * e.points;
+            credits += sign * e.credits;
+        }
+
+        double GPA() const { return credits > 0 ? qualityPoints / credits : 0.0; }
+    };
+
+    struct Transcript {
+        unordered_map<string, Entry> entries; // key: term + '\x1f' + courseCode
+        unordered_map<string, Totals> terms;
+        Totals overall;
+        Student* student = nullptr;           // kept in sync when registered
+    };
+
+    unordered_map<string, Transcript> transcripts;
+
+    static string entryKey(const string& term, const string& courseCode) { return term + '\x1f' + courseCode; }
+
+    static void syncStudent(Transcript& t) {
+        if (t.student) t.student->setGPA(t.overall.GPA());
+    }
+
+public:
+    // Registered students get their GPA field updated on every change.
+    void registerStudent(Student* student) {
+        Transcript& t = transcripts[student->getID()];
+        t.student = student;
+        syncStudent(t);
+    }
+
+    void setGrade(const string& studentID, const string& courseCode, const string& term, int credits, double score) {
+        if (GradeBook::validateGrade(score) != ErrorCode::None)
+            throw GradeException("Invalid grade entry: " + to_string(score));
+        if (credits <= 0) throw GradeException("Credits must be positive for " + courseCode);
+
+        Transcript& t = transcripts[studentID];
+        Totals& termTotals = t.terms[term];
+        Entry updated{credits, score, gradePoints(score)};
+        auto inserted = t.entries.emplace(entryKey(term, courseCode), updated);
+        if (!inserted.second) {
+            Entry& old = inserted.first->second;
+            t.overall.add(old, -1);
+            termTotals.add(old, -1);
+            old = updated;
+        }
+        t.overall.add(updated, +1);
+        termTotals.add(updated, +1);
+        syncStudent(t);
+    }
+
+    void setGrade(const Student& student, const Course& course, const string& term, double score) {
+        setGrade(student.getID(), course.getCode(), term, course.getCredits(), score);
+    }
+
+    double getGPA(const string& studentID) const {
+        auto it = transcripts.find(studentID);
+        return it != transcripts.end() ? it->second.overall.GPA() : 0.0;
+    }
+
+    double getTermGPA(const string& studentID, const string& term) const {
+        auto it = transcripts.find(studentID);
+        if (it == transcripts.end()) return 0.0;
+        auto termIt = it->second.terms.find(term);
+        return termIt != it->second.terms.end() ? termIt->second.GPA() : 0.0;
+    }
+
+    int getCredits(const string& studentID) const {
+        auto it = transcripts.find(studentID);
+        return it != transcripts.end() ? it->second.overall.credits : 0;
+    }
+
+    // End-of-term pass: rebuilds every total from its entries, partitioned across threads.
+    void recomputeAll(unsigned threadCount = 0) {
+        vector<Transcript*> all;
+        all.reserve(transcripts.size());
+        for (auto& entry : transcripts) all.push_back(&entry.second);
+        if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+        threadCount = max(1u, min<unsigned>(threadCount, static_cast<unsigned>(all.size() / 1024 + 1)));
+
+        auto rebuild = [&all](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Transcript& t = *all[i];
+                t.overall = Totals();
+                t.terms.clear();
+                for (const auto& e : t.entries) {
+                    t.overall.add(e.second, +1);
+                    t.terms[e.first.substr(0, e.first.find('\x1f'))].add(e.second, +1);
+                }
+                syncStudent(t);
+            }
+        };
+        size_t chunk = (all.size() + threadCount - 1) / threadCount;
+        vector<thread> workers;
+        for (unsigned w = 1; w < threadCount; ++w)
+            workers.emplace_back(rebuild, min(all.size(), w * chunk), min(all.size(), (w + 1) * chunk));
+        rebuild(0, min(all.size(), chunk));
+        for (auto& w : workers) w.join();
+    }
+};
+
+// ===================== Grade History =====================
+
+// Append-only log of every grade ever entered. Open terms keep plain columns
+// (student, course, score, timestamp) that are scanned 64 rows at a time into
+// match bitmaps. closeTerm() freezes a term into a compressed stream sorted by
+// student: varint student deltas, varint course handles, scores quantized to
+// hundredths in 16 bits and zigzag timestamp deltas, cut into blocks of 128
+// rows with a small header so student lookups only decode the blocks they need.
+class GradeHistory {
+public:
+    struct Event {
+        uint32_t student, course, term;
+        double score;
+        int64_t timestamp;
+    };
+
+private:
+    static const size_t BlockRows = 128;
+
+    struct OpenColumns {
+        vector<uint32_t> student, course;
+        vector<double> score;
+        vector<int64_t> timestamp;
+    };
+
+    struct Block {
+        uint32_t firstStudent, lastStudent;
+        uint32_t offset; // into bytes
+        uint32_t rows;
+    };
+
+    struct ClosedColumns {
+        vector<Block> blocks;
+        vector<uint8_t> bytes;
+        size_t rows = 0;
+    };
+
+    struct Term {
+        bool closed = false;
+        OpenColumns open;
+        ClosedColumns packed;
+    };
+
+    unordered_map<string, uint32_t> studentIds, courseIds, termIds;
+    vector<string> studentNames, courseNames, termNames;
+    vector<Term> terms;
+
+    static uint32_t handleFor(unordered_map<string, uint32_t>& ids, vector<string>& names, const string& key) {
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+        uint32_t handle = static_cast<uint32_t>(names.size());
+        ids.emplace(key, handle);
+        names.push_back(key);
+        return handle;
+    }
+
+    static uint32_t find(const unordered_map<string, uint32_t>& ids, const string& key) {
+        auto it = ids.find(key);
+        return it != ids.end() ? it->second : UINT32_MAX;
+    }
+
+    static void putVarint(vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t getVarint(const uint8_t*& in) {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = *in++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+    }
+
+    static uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    static int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    // Branch-free equality scan producing one bit per row; compilers vectorize the inner loop.
+    template <typename F>
+    static void scanEqual(const vector<uint32_t>& column, uint32_t wanted, F onRow) {
+        const uint32_t* data = column.data();
+        size_t n = column.size();
+        for (size_t base = 0; base < n; base += 64) {
+            size_t width = min<size_t>(64, n - base);
+            uint64_t matches = 0;
+            for (size_t j = 0; j < width; ++j) matches |= uint64_t(data[base + j] == wanted) << j;
+            for (; matches; matches &= matches - 1) onRow(base + __builtin_ctzll(matches));
+        }
+    }
+
+    template <typename F>
+    static void decodeBlock(const ClosedColumns& packed, const Block& block, uint32_t term, F onEvent) {
+        const uint8_t* in = packed.bytes.data() + block.offset;
+        uint32_t student = block.firstStudent;
+        int64_t timestamp = 0;
+        for (uint32_t r = 0; r < block.rows; ++r) {
+            student += static_cast<uint32_t>(getVarint(in));
+            uint32_t course = static_cast<uint32_t>(getVarint(in));
+            uint16_t quantized = static_cast<uint16_t>(in[0] | (in[1] << 8));
+            in += 2;
+            timestamp += unzigzag(getVarint(in));
+            onEvent(Event{student, course, term, quantized / 100.0, timestamp});
+        }
+    }
+
+public:
+    static int64_t now() {
+        return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void append(const string& studentID, const string& courseCode, const string& term, double score, int64_t timestamp = now()) {
+        if (GradeBook::validateGrade(score) != ErrorCode::None)
+            throw GradeException("Invalid grade entry: " + to_string(score));
+        uint32_t termId = handleFor(termIds, termNames, term);
+        if (termId == terms.size()) terms.emplace_back();
+        Term& t = terms[termId];
+        if (t.closed) throw GradeException("Term is closed: " + term);
+        t.open.student.push_back(handleFor(studentIds, studentNames, studentID));
+        t.open.course.push_back(handleFor(courseIds, courseNames, courseCode));
+        t.open.score.push_back(score);
+        t.open.timestamp.push_back(timestamp);
+    }
+
+    // Freezes a term into its compressed form; later appends to it are rejected.
+    void closeTerm(const string& term) {
+        uint32_t termId = find(termIds, term);
+        if (termId == UINT32_MAX || terms[termId].closed) return;
+        Term& t = terms[termId];
+        OpenColumns& open = t.open;
+
+        vector<uint32_t> order(open.student.size());
+        for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+        stable_sort(order.begin(), order.end(), [&open](uint32_t a, uint32_t b) {
+            if (open.student[a] != open.student[b]) return open.student[a] < open.student[b];
+            return open.timestamp[a] < open.timestamp[b];
+        });
+
+        ClosedColumns& packed = t.packed;
+        packed.rows = order.size();
+        for (size_t start = 0; start < order.size(); start += BlockRows) {
+            size_t end = min(order.size(), start + BlockRows);
+            Block block{open.student[order[start]], open.student[order[end - 1]],
+                        static_cast<uint32_t>(packed.bytes.size()), static_cast<uint32_t>(end - start)};
+            uint32_t previousStudent = block.firstStudent;
+            int64_t previousTime = 0;
+            for (size_t k = start; k < end; ++k) {
+                uint32_t row = order[k];
+                putVarint(packed.bytes, open.student[row] - previousStudent);
+                putVarint(packed.bytes, open.course[row]);
+                uint16_t quantized = static_cast<uint16_t>(open.score[row] * 100.0 + 0.5);
+                packed.bytes.push_back(static_cast<uint8_t>(quantized));
+                packed.bytes.push_back(static_cast<uint8_t>(quantized >> 8));
+                putVarint(packed.bytes, zigzag(open.timestamp[row] - previousTime));
+                previousStudent = open.student[row];
+                previousTime = open.timestamp[row];
+            }
+            packed.blocks.push_back(block);
+        }
+        packed.bytes.shrink_to_fit();
+        open = OpenColumns();
+        t.closed = true;
+    }
+
+    template <typename F>
+    void forEachInTerm(const string& term, F onEvent) const {
+        uint32_t termId = find(termIds, term);
+        if (termId == UINT32_MAX) return;
+        const Term& t = terms[termId];
+        if (t.closed) {
+            for (const Block& block : t.packed.blocks) decodeBlock(t.packed, block, termId, onEvent);
+            return;
+        }
+        for (size_t i = 0; i < t.open.student.size(); ++i)
+            onEvent(Event{t.open.student[i], t.open.course[i], termId, t.open.score[i], t.open.timestamp[i]});
+    }
+
+    // Every grade the student ever received, term by term in the order terms were first seen.
+    template <typename F>
+    void forEachForStudent(const string& studentID, F onEvent) const {
+        uint32_t student = find(studentIds, studentID);
+        if (student == UINT32_MAX) return;
+        for (uint32_t termId = 0; termId < terms.size(); ++termId) {
+            const Term& t = terms[termId];
+            if (t.closed) {
+                const vector<Block>& blocks = t.packed.blocks;
+                auto it = lower_bound(blocks.begin(), blocks.end(), student,
+                                      [](const Block& b, uint32_t s) { return b.lastStudent < s; });
+                for (; it != blocks.end() && it->firstStudent <= student; ++it)
+                    decodeBlock(t.packed, *it, termId, [&](const Event& e) { if (e.student == student) onEvent(e); });
+            } else {
+                scanEqual(t.open.student, student, [&](size_t i) {
+                    onEvent(Event{student, t.open.course[i], termId, t.open.score[i], t.open.timestamp[i]});
+                });
+            }
+        }
+    }
+
+    const string& studentID(uint32_t handle) const { return studentNames[handle]; }
+    const string& courseCode(uint32_t handle) const { return courseNames[handle]; }
+    const string& termName(uint32_t handle) const { return termNames[handle]; }
+
+    size_t bytesUsed() const {
+        size_t bytes = 0;
+        for (const Term& t : terms) {
+            bytes += t.open.student.capacity() * sizeof(uint32_t) * 2 + t.open.score.capacity() * sizeof(double)
+                   + t.open.timestamp.capacity() * sizeof(int64_t);
+            bytes += t.packed.bytes.capacity() + t.packed.blocks.capacity() * sizeof(Block);
+        }
+        return bytes;
+    }
+};
+
+// ===================== CSV Import =====================
+
+struct ImportOptions {
+    size_t chunkSize = 4 << 20;
+    unsigned workers = 0;         // 0 = hardware_concurrency()
+    size_t maxChunksInFlight = 0; // 0 = 2 * workers; bounds memory regardless of file size
+    size_t maxLineLength = 1 << 20; // longer lines are skipped and reported as LineTooLong
+};
+
+// Streaming importer for the SIS feed. One record per line, first field is
+// the record type (quoted fields may contain commas but not newlines):
+//   undergrad,name,age,ID,contact,enrollmentDate,program,GPA,major,minor,gradDate
+//   grad,name,age,ID,contact,enrollmentDate,program,GPA,topic,advisor,thesis
+//   assistant|associate|full,name,age,ID,contact,department,specialization,hireDate
+//   course,code,title,credits,description
+//   grade,studentID,grade
+//   enroll,courseCode,studentID
+// A reader thread cuts the input into chunks on line boundaries, workers parse
+// and validate chunks in parallel, and the calling thread applies results in
+// file order so sinks, GradeBook and EnrollmentManager need no locking.
+class CsvImporter {
+public:
+    function<void(unique_ptr<Person>)> onPerson;
+    function<void(unique_ptr<Course>)> onCourse;
+
+private:
+    struct Chunk {
+        size_t sequence;
+        size_t firstLine;
+        string text;
+        bool oversized = false; // stands for one skipped line; text is empty
+    };
+
+    struct Parsed {
+        vector<unique_ptr<Person>> people;
+        vector<unique_ptr<Course>> courses;
+        vector<pair<string, double>> grades;
+        vector<pair<string, string>> enrollments;
+        BatchReport report;
+    };
+
+    static const size_t MaxFields = 12;
+
+    GradeBook& gradeBook;
+    EnrollmentManager& enrollment;
+    ImportOptions options;
+
+    static size_t splitFields(string_view line, string_view* fields, string& scratch) {
+        size_t count = 0;
+        size_t i = 0;
+        while (count < MaxFields) {
+            if (i < line.size() && line[i] == '"') {
+                // Quoted field: unescape "" into scratch, which is reserved up front so views stay valid.
+                size_t start = scratch.size();
+                for (++i; i < line.size(); ++i) {
+                    if (line[i] == '"') {
+                        if (i + 1 < line.size() && line[i + 1] == '"') ++i;
+                        else { ++i; break; }
+                    }
+                    scratch.push_back(line[i]);
+                }
+                fields[count++] = string_view(scratch.data() + start, scratch.size() - start);
+                if (i < line.size() && line[i] != ',') return MaxFields + 1;
+            } else {
+                size_t end = line.find(',', i);
+                if (end == string_view::npos) end = line.size();
+                fields[count++] = line.substr(i, end - i);
+                i = end;
+            }
+            if (i >= line.size()) return count;
+            ++i; // skip the comma
+        }
+        return MaxFields + 1;
+    }
+
+    template <typename N>
+    static bool toNumber(string_view field, N& value) {
+        const char* end = field.data() + field.size();
+        auto result = from_chars(field.data(), end, value);
+        return result.ec == errc() && result.ptr == end;
+    }
+
+    // Same rules as the interactive API: ID present, '@' in contact, age 1-120, GPA 0-4.
+    static ErrorCode validatePerson(int age, string_view ID, string_view contact) {
+        if (age <= 0 || age > 120) return ErrorCode::InvalidAge;
+        if (ID.empty()) return ErrorCode::InvalidID;
+        if (contact.find('@') == string_view::npos) return ErrorCode::InvalidContact;
+        return ErrorCode::None;
+    }
+
+    static ErrorCode parseLine(string_view line, Parsed& out, string& scratch) {
+        string_view f[MaxFields];
+        scratch.clear();
+        scratch.reserve(line.size());
+        size_t n = splitFields(line, f, scratch);
+        if (n > MaxFields) return ErrorCode::MalformedRecord;
+        string_view type = f[0];
+        auto s = [](string_view v) { return string(v); };
+
+        if (type == "undergrad" || type == "grad") {
+            int age;
+            double GPA;
+            if (n != 11 || !toNumber(f[2], age) || !toNumber(f[7], GPA)) return ErrorCode::MalformedRecord;
+            ErrorCode code = validatePerson(age, f[3], f[4]);
+            if (code != ErrorCode::None) return code;
+            if (!(GPA >= 0.0 && GPA <= 4.0)) return ErrorCode::InvalidGPA;
+            if (type == "undergrad")
+                out.people.emplace_back(new UndergraduateStudent(s(f[1]), age, s(f[3]), s(f[4]), s(f[5]), s(f[6]), GPA, s(f[8]), s(f[9]), s(f[10])));
+            else
+                out.people.emplace_back(new GraduateStudent(s(f[1]), age, s(f[3]), s(f[4]), s(f[5]), s(f[6]), GPA, s(f[8]), s(f[9]), s(f[10])));
+        } else if (type == "assistant" || type == "associate" || type == "full") {
+            int age;
+            if (n != 8 || !toNumber(f[2], age)) return ErrorCode::MalformedRecord;
+            ErrorCode code = validatePerson(age, f[3], f[4]);
+            if (code != ErrorCode::None) return code;
+            if (type == "assistant")
+                out.people.emplace_back(new AssistantProfessor(s(f[1]), age, s(f[3]), s(f[4]), s(f[5]), s(f[6]), s(f[7])));
+            else if (type == "associate")
+                out.people.emplace_back(new AssociateProfessor(s(f[1]), age, s(f[3]), s(f[4]), s(f[5]), s(f[6]), s(f[7])));
+            else
+                out.people.emplace_back(new FullProfessor(s(f[1]), age, s(f[3]), s(f[4]), s(f[5]), s(f[6]), s(f[7])));
+        } else if (type == "course") {
+            int credits;
+            if (n != 5 || !toNumber(f[3], credits)) return ErrorCode::MalformedRecord;
+            if (f[1].empty()) return ErrorCode::InvalidCourseCode;
+            out.courses.emplace_back(new Course(s(f[1]), s(f[2]), credits, s(f[4])));
+        } else if (type == "grade") {
+            double grade;
+            if (n != 3 || !toNumber(f[2], grade)) return ErrorCode::MalformedRecord;
+            if (f[1].empty()) return ErrorCode::InvalidStudentID;
+            ErrorCode code = GradeBook::validateGrade(grade);
+            if (code != ErrorCode::None) return code;
+            out.grades.emplace_back(s(f[1]), grade);
+        } else if (type == "enroll") {
+            if (n != 3) return ErrorCode::MalformedRecord;
+            if (f[1].empty()) return ErrorCode::InvalidCourseCode;
+            if (f[2].empty()) return ErrorCode::InvalidStudentID;
+            out.enrollments.emplace_back(s(f[1]), s(f[2]));
+        } else {
+            return ErrorCode::UnknownRecordType;
+        }
+        return ErrorCode::None;
+    }
+
+    static void parseChunk(const Chunk& chunk, Parsed& out) {
+        if (chunk.oversized) {
+            out.report.record(chunk.firstLine, ErrorCode::LineTooLong);
+            return;
+        }
+        string scratch;
+        size_t line = chunk.firstLine;
+        size_t pos = 0;
+        while (pos < chunk.text.size()) {
+            size_t end = chunk.text.find('\n', pos);
+            if (end == string::npos) end = chunk.text.size();
+            string_view record(chunk.text.data() + pos, end - pos);
+            if (!record.empty() && record.back() == '\r') record.remove_suffix(1);
+            if (!record.empty()) out.report.record(line, parseLine(record, out, scratch));
+            pos = end + 1;
+            ++line;
+        }
+    }
+
+public:
+    CsvImporter(GradeBook& gradeBook, EnrollmentManager& enrollment, const ImportOptions& options = ImportOptions())
+        : gradeBook(gradeBook), enrollment(enrollment), options(options) {}
+
+    // Row indices in the report are 1-based line numbers.
+    BatchReport importFile(const string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw UniversitySystemException("Cannot open import file: " + path);
+        BatchReport report;
+        try {
+            report = importFd(fd);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+        return report;
+    }
+
+    BatchReport importFd(int fd) {
+        unsigned workerCount = options.workers ? options.workers : max(1u, thread::hardware_concurrency());
+        size_t maxInFlight = options.maxChunksInFlight ? options.maxChunksInFlight : 2 * workerCount;
+
+        mutex m;
+        condition_variable workReady, doneReady, spaceFree;
+        queue<Chunk> work;
+        map<size_t, Parsed> done;
+        size_t inFlight = 0, totalChunks = 0;
+        bool readerDone = false, aborted = false; // aborted: a sink threw, stop every thread
+        int readError = 0;
+
+        thread reader([&]() {
+            string carry;
+            vector<char> buffer(options.chunkSize);
+            size_t sequence = 0, lineCount = 0;
+            auto submit = [&](string text, bool oversized) {
+                Chunk chunk{sequence++, lineCount + 1, move(text), oversized};
+                lineCount += oversized ? 1 : count(chunk.text.begin(), chunk.text.end(), '\n');
+                unique_lock<mutex> lock(m);
+                spaceFree.wait(lock, [&] { return inFlight < maxInFlight || aborted; });
+                if (aborted) return false;
+                ++inFlight;
+                work.push(move(chunk));
+                workReady.notify_one();
+                return true;
+            };
+            // A line with no newline within maxLineLength is dropped: carry is
+            // cleared and input is skipped up to the next newline, which ends
+            // that line's LineTooLong row.
+            bool stopped = false, skipping = false;
+            while (!stopped) {
+                ssize_t got = read(fd, buffer.data(), buffer.size());
+                if (got < 0 && errno == EINTR) continue;
+                if (got < 0) {
+                    lock_guard<mutex> lock(m);
+                    readError = errno;
+                    stopped = true;
+                    break;
+                }
+                if (got == 0) break;
+                const char* data = buffer.data();
+                if (skipping) {
+                    const char* newline = static_cast<const char*>(memchr(data, '\n', got));
+                    if (!newline) continue;
+                    skipping = false;
+                    if (!submit(string(), true)) break;
+                    got -= newline + 1 - data;
+                    data = newline + 1;
+                    if (got == 0) continue;
+                }
+                const char* lastNewline = static_cast<const char*>(memrchr(data, '\n', got));
+                if (!lastNewline) {
+                    if (carry.size() + got > options.maxLineLength) {
+                        string().swap(carry);
+                        skipping = true;
+                    } else {
+                        carry.append(data, got);
+                    }
+                    continue;
+                }
+                string text;
+                text.reserve(carry.size() + (lastNewline - data) + 1);
+                text.append(carry).append(data, lastNewline + 1);
+                carry.assign(lastNewline + 1, data + got);
+                stopped = !submit(move(text), false);
+            }
+            if (!stopped && skipping) submit(string(), true);
+            else if (!stopped && !carry.empty()) submit(move(carry), false);
+            lock_guard<mutex> lock(m);
+            totalChunks = sequence;
+            readerDone = true;
+            workReady.notify_all();
+            doneReady.notify_all();
+        });
+
+        vector<thread> workers;
+        for (unsigned w = 0; w < workerCount; ++w) {
+            workers.emplace_back([&]() {
+                while (true) {
+                    unique_lock<mutex> lock(m);
+                    workReady.wait(lock, [&] { return !work.empty() || readerDone || aborted; });
+                    if (work.empty() || aborted) return;
+                    Chunk chunk = move(work.front());
+                    work.pop();
+                    lock.unlock();
+
+                    Parsed parsed;
+                    parseChunk(chunk, parsed);
+
+                    lock.lock();
+                    done.emplace(chunk.sequence, move(parsed));
+                    doneReady.notify_all();
+                }
+            });
+        }
+
+        // Results are applied in file order on this thread. If a sink throws,
+        // the reader and workers are told to stop and joined before rethrowing.
+        BatchReport report;
+        exception_ptr failure;
+        try {
+            for (size_t next = 0;; ++next) {
+                unique_lock<mutex> lock(m);
+                doneReady.wait(lock, [&] { return done.count(next) || (readerDone && next >= totalChunks); });
+                if (!done.count(next)) break;
+                Parsed parsed = move(done[next]);
+                done.erase(next);
+                lock.unlock();
+
+                for (auto& person : parsed.people)
+                    if (onPerson) onPerson(move(person));
+                for (auto& course : parsed.courses)
+                    if (onCourse) onCourse(move(course));
+                gradeBook.addGrades(parsed.grades);
+                enrollment.enrollStudents(parsed.enrollments);
+                report.merge(parsed.report);
+
+                lock.lock();
+                --inFlight;
+                spaceFree.notify_one();
+            }
+        } catch (...) {
+            failure = current_exception();
+            lock_guard<mutex> lock(m);
+            aborted = true;
+            spaceFree.notify_all();
+            workReady.notify_all();
+        }
+
+        reader.join();
+        for (auto& w : workers) w.join();
+        if (failure) rethrow_exception(failure);
+        if (readError)
+            throw UniversitySystemException(string("Import read failed: ") + strerror(readError));
+        return report;
+    }
+};
+
+
+// Registration-rush stress test: every thread hammers one hot course.
+void benchmarkSeatReservation(unsigned maxThreads, int attemptsPerThread) {
+    for (unsigned threads = 1; threads <= maxThreads; threads = (threads < maxThreads && threads * 2 > maxThreads) ? maxThreads : threads * 2) {
+        Course hot("HOT100", "Hot Course", 3, "Stress target");
+        int capacity = attemptsPerThread * static_cast<int>(threads) / 2;
+        hot.setMaxStudents(capacity);
+        atomic<long> accepted{0};
+
+        // Each thread cycles through its own slice of distinct students. The
+        // slices together hold more than capacity, so the course fills up;
+        // repeats only happen once a thread has tried its whole slice.
+        size_t slice = static_cast<size_t>(capacity) / threads + 1;
+        vector<UndergraduateStudent> pool;
+        pool.reserve(slice * threads);
+        for (size_t i = 0; i < slice * threads; ++i)
+            pool.emplace_back("Bench", 20, "S" + to_string(i), "bench@email.com", "2024", "CS", 3.0, "CS", "None", "2028");
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                UndergraduateStudent* mySlice = &pool[t * slice];
+                long mine = 0;
+                for (int i = 0; i < attemptsPerThread; ++i)
+                    if (hot.tryEnrollStudent(&mySlice[i % slice])) ++mine;
+                accepted += mine;
+            });
+        }
+        for (auto& w : workers) w.join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        long attempts = static_cast<long>(attemptsPerThread) * threads;
+        cout << "threads=" << threads << " attempts=" << attempts << " enrolled=" << accepted
+             << " capacityRespected=" << (accepted == capacity && hot.getEnrolledCount() == capacity ? "yes" : "no")
+             << " Mops/s=" << attempts / seconds / 1e6 << endl;
+    }
+}
+
+// Producer-side cost of logging, plus how many lines the writer kept up with.
+void benchmarkErrorLogger(unsigned threads, int messagesPerThread) {
+    char path[] = "/tmp/bench_errors-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return;
+    close(fd);
+    ErrorLoggerConfig config;
+    config.path = path;
+    config.capacity = 1 << 16;
+    ErrorLogger logger(config);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&logger, messagesPerThread]() {
+            for (int i = 0; i < messagesPerThread; ++i)
+                logger.log("Grade Error: Invalid grade entry: 101.000000");
+        });
+    }
+    for (auto& w : workers) w.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    logger.flush();
+
+    cout << "logger threads=" << threads << " ns/log=" << seconds * 1e9 / (static_cast<double>(threads) * messagesPerThread)
+         << " logged=" << logger.getLoggedCount() << " dropped=" << logger.getDroppedCount()
+         << " batches=" << logger.getBatchCount() << endl;
+    unlink(path);
+}
+
+// Generates a mixed feed with a sprinkling of bad rows and imports it.
+void benchmarkCsvImport(size_t studentCount) {
+    const string path = "bench_import.csv";
+    {
+        ofstream out(path);
+        out << "course,CS101,\"Intro, to CS\",3,Basics\n";
+        for (size_t i = 0; i < studentCount; ++i) {
+            string id = "S" + to_string(1000000 + i);
+            double gpa = (i % 1000 == 0) ? 4.5 : 2.0 + (i % 20) / 10.0;
+            out << "undergrad,Student " << i << ",20," << id << "," << id << "@mail.com,2022-09-01,CS," << gpa << ",CS,Math,2026\n";
+            out << "grade," << id << "," << (i % 101) << "\n";
+            out << "enroll,CS101," << id << "\n";
+        }
+    }
+
+    GradeBook gradeBook;
+    EnrollmentManager enrollment;
+    CsvImporter importer(gradeBook, enrollment);
+    size_t people = 0;
+    importer.onPerson = [&people](unique_ptr<Person>) { ++people; };
+
+    auto start = chrono::steady_clock::now();
+    BatchReport report = importer.importFile(path);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "csv import rows=" << report.total << " people=" << people << " ms=" << seconds * 1e3
+         << " rows/s=" << report.total / seconds << " ";
+    report.print(cout);
+    remove(path.c_str());
+}
+
+// Payroll and validation over the same people stored as vector<Person*>
+// (heap objects in arrival order) and in a TypedRoster.
+void benchmarkTypedRoster(size_t rosterSize) {
+    PersonRoster roster;
+    vector<unique_ptr<Person>> heap;
+    vector<Person*> people;
+    heap.reserve(rosterSize);
+    people.reserve(rosterSize);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < rosterSize; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        string id = to_string(i), contact = "p" + id + "@email.com";
+        double gpa = (i % 1000 == 0) ? 4.5 : 2.0 + (i % 20) / 10.0;
+        switch (seed >> 29) {
+            case 0: case 1: case 2:
+                heap.emplace_back(new UndergraduateStudent("U", 20, "U" + id, contact, "2022", "CS", gpa, "CS", "Math", "2026"));
+                roster.add(*static_cast<UndergraduateStudent*>(heap.back().get()));
+                break;
+            case 3: case 4:
+                heap.emplace_back(new GraduateStudent("G", 25, "G" + id, contact, "2021", "CS", gpa, "Topic", "Advisor", "Thesis"));
+                roster.add(*static_cast<GraduateStudent*>(heap.back().get()));
+                break;
+            case 5:
+                heap.emplace_back(new AssistantProfessor("A", 35, "A" + id, contact, "CS", "Spec", "2018"));
+                roster.add(*static_cast<AssistantProfessor*>(heap.back().get()));
+                break;
+            case 6:
+                heap.emplace_back(new AssociateProfessor("B", 45, "B" + id, contact, "CS", "Spec", "2010"));
+                roster.add(*static_cast<AssociateProfessor*>(heap.back().get()));
+                break;
+            default:
+                heap.emplace_back(new FullProfessor("F", 55, "F" + id, contact, "CS", "Spec", "2000"));
+                roster.add(*static_cast<FullProfessor*>(heap.back().get()));
+        }
+    }
+    // Interleave allocations the way a long-running process scatters them.
+    for (size_t i = 0; i < heap.size(); ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        swap(heap[i], heap[seed % heap.size()]);
+    }
+    for (const auto& p : heap) people.push_back(p.get());
+
+    auto time = [](auto&& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    double virtualTotal = 0.0, typedTotal = 0.0;
+    size_t virtualRejected = 0, typedRejected = 0;
+    double virtualPay = time([&]() {
+        for (Person* p : people) virtualTotal += p->calculatePayment();
+    });
+    double typedPay = time([&]() { typedTotal = roster.totalPayment(); });
+    double virtualCheck = time([&]() {
+        for (Person* p : people) {
+            bool bad = p->getAge() <= 0 || p->getAge() > 120 || Person::validate(p->getID(), p->getContact()) != ErrorCode::None;
+            if (const Student* s = dynamic_cast<const Student*>(p)) bad = bad || !(s->getGPA() >= 0.0 && s->getGPA() <= 4.0);
+            virtualRejected += bad;
+        }
+    });
+    double typedCheck = time([&]() { typedRejected = roster.validate().failed(); });
+
+    cout << "roster n=" << rosterSize << " payment virtual=" << virtualPay << "ms typed=" << typedPay
+         << "ms validate virtual=" << virtualCheck << "ms typed=" << typedCheck << "ms match="
+         << (virtualTotal == typedTotal && virtualRejected == typedRejected ? "yes" : "no") << endl;
+}
+
+// Columnar history scans over a large log, before and after closing terms.
+void benchmarkGradeHistory(size_t rowsPerTerm, int termCount) {
+    GradeHistory history;
+    int64_t timestamp = 1700000000;
+    for (int t = 0; t < termCount; ++t) {
+        string term = "T" + to_string(t);
+        for (size_t i = 0; i < rowsPerTerm; ++i)
+            history.append("S" + to_string(i % 100000), "C" + to_string(i % 500), term, static_cast<double>(i % 101), timestamp++);
+    }
+    size_t openBytes = history.bytesUsed();
+
+    auto time = [](auto&& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e3;
+    };
+    size_t found = 0;
+    double openStudent = time([&] { history.forEachForStudent("S4242", [&](const GradeHistory::Event&) { ++found; }); });
+    for (int t = 0; t < termCount; ++t) history.closeTerm("T" + to_string(t));
+    double closedStudent = time([&] { history.forEachForStudent("S4242", [&](const GradeHistory::Event&) { ++found; }); });
+    double sum = 0;
+    double closedTerm = time([&] { history.forEachInTerm("T0", [&](const GradeHistory::Event& e) { sum += e.score; }); });
+
+    cout << "history rows=" << rowsPerTerm * termCount << " open=" << openBytes / (1024 * 1024) << "MiB closed="
+         << history.bytesUsed() / (1024 * 1024) << "MiB student(open)=" << openStudent << "ms student(closed)="
+         << closedStudent << "ms term(closed)=" << closedTerm << "ms matches=" << found << " termSum=" << sum << endl;
+}
+
+// Builds a layered prerequisite DAG edge by edge, checks the incremental
+// closure against a DFS, then times eligibility checks against a per-check
+// DFS over prerequisite codes with completed courses in a hash set.
+void benchmarkPrerequisites(int courseCount, int edgesPerCourse, size_t checks) {
+    mt19937 rng(7);
+    vector<string> codes;
+    for (int i = 0; i < courseCount; ++i) codes.push_back("P" + to_string(i));
+    vector<vector<int>> edges(courseCount);
+    for (int i = 1; i < courseCount; ++i)
+        for (int e = 0; e < edgesPerCourse; ++e) edges[i].push_back(static_cast<int>(rng() % i));
+
+    PrerequisiteGraph graph;
+    auto start = chrono::steady_clock::now();
+    size_t added = 0;
+    for (int i = 1; i < courseCount; ++i)
+        for (int p : edges[i]) added += graph.addPrerequisite(codes[i], codes[p]);
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    size_t mismatches = 0;
+    for (int i = 0; i < courseCount; i += max(1, courseCount / 64)) {
+        vector<char> seen(courseCount, 0);
+        vector<int> stack{ i };
+        while (!stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            for (int p : edges[c])
+                if (!seen[p]) { seen[p] = 1; stack.push_back(p); }
+        }
+        for (int j = 0; j < courseCount; ++j)
+            mismatches += (seen[j] != 0) != graph.isPrerequisite(codes[i], codes[j]);
+    }
+
+    GradeBook grades;
+    unordered_map<string, unordered_set<string>> passed;
+    const int studentCount = 256;
+    for (int s = 0; s < studentCount; ++s) {
+        string id = "S" + to_string(s);
+        int reach = static_cast<int>(rng() % courseCount);
+        for (int c = 0; c < reach; ++c)
+            if (rng() % 16) {
+                grades.addCourseGrade(id, codes[c], 75);
+                passed[id].insert(codes[c]);
+            }
+    }
+    vector<pair<string, int>> queries;
+    for (size_t q = 0; q < checks; ++q)
+        queries.emplace_back("S" + to_string(rng() % studentCount), static_cast<int>(rng() % courseCount));
+    vector<uint32_t> indices;
+    for (const string& code : codes) indices.push_back(courseIndex().intern(code));
+
+    start = chrono::steady_clock::now();
+    size_t eligible = 0;
+    for (const auto& q : queries)
+        eligible += grades.hasCompleted(q.first, graph.requiredFor(indices[q.second]));
+    double bitsetUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / checks;
+
+    start = chrono::steady_clock::now();
+    size_t naiveEligible = 0;
+    for (const auto& q : queries) {
+        const unordered_set<string>& done = passed[q.first];
+        vector<char> seen(courseCount, 0);
+        vector<int> stack{ q.second };
+        bool ok = true;
+        while (ok && !stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            for (int p : edges[c]) {
+                if (seen[p]) continue;
+                seen[p] = 1;
+                if (!done.count(codes[p])) { ok = false; break; }
+                stack.push_back(p);
+            }
+        }
+        naiveEligible += ok;
+    }
+    double naiveUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / checks;
+
+    cout << "prerequisites courses=" << courseCount << " edges=" << added << " build=" << buildMs << "ms mismatches="
+         << mismatches << " check(bitset)=" << bitsetUs << "us check(dfs)=" << naiveUs << "us eligible="
+         << eligible << "/" << naiveEligible << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        unsigned cores = max(1u, thread::hardware_concurrency());
+        benchmarkSeatReservation(cores, 1000000);
+        benchmarkErrorLogger(cores, 200000);
+        benchmarkCsvImport(1000000);
+        benchmarkGradeHistory(2000000, 4);
+        benchmarkTypedRoster(2000000);
+        benchmarkPrerequisites(4096, 3, 200000);
+        return 0;
+    }
 
-int main() {
     try {
         UndergraduateStudent u("Alice", 20, "S123", "alice@email.com", "2022", "CS", 3.5, "CS", "Math", "2025");
         GraduateStudent g("Bob", 25, "S124", "bob@email.com", "2021", "Physics", 3.8, "Quantum", "Dr. Smith", "Dark Matter");
@@ -285,12 +2097,85 @@ int main() {
         c.setInstructor(&ap);
         c.enrollStudent(&u);
 
+        Course seminar("CS499", "Senior Seminar", 3, "Capstone discussion");
+        seminar.setMaxStudents(1);
+        seminar.enrollOrWaitlist(&u);
+        if (seminar.enrollOrWaitlist(&g, 1) == EnrollStatus::Waitlisted)
+            cout << "Waitlisted for CS499: " << seminar.getWaitlistSize() << endl;
+        if (seminar.enrollOrWaitlist(&g) == EnrollStatus::AlreadyWaitlisted)
+            cout << "Duplicate CS499 request rejected" << endl;
+        seminar.dropStudent(&u);
+        cout << "Promoted into CS499: " << (seminar.isEnrolled(&g) ? "yes" : "no") << endl;
+
         University uni;
         uni.addDepartment(d);
 
         GradeBook gb;
         gb.addGrade("S123", 90);
 
+        PrerequisiteGraph prerequisites;
+        prerequisites.addPrerequisite("CS201", "CS101");
+        prerequisites.addPrerequisite("CS301", "CS201");
+        prerequisites.addPrerequisite("CS301", "MATH202");
+        try {
+            prerequisites.addPrerequisite("CS101", "CS301");
+        } catch (const PrerequisiteException& e) {
+            cout << e.what() << endl;
+        }
+        Course compilers("CS301", "Compilers", 4, "Parsing and code generation");
+        compilers.setPrerequisiteCheck(&prerequisites, &gb);
+        gb.addCourseGrade("S123", "CS101", 92);
+        gb.addCourseGrade("S123", "CS201", 88);
+        try {
+            compilers.enrollStudent(&u);
+        } catch (const EnrollmentException& e) {
+            cout << e.what() << endl;
+        }
+        gb.addCourseGrade("S123", "MATH202", 85);
+        compilers.enrollStudent(&u);
+        cout << "Alice in CS301: " << (compilers.isEnrolled(&u) ? "yes" : "no") << endl;
+        if (compilers.enrollOrWaitlist(&g) == EnrollStatus::Ineligible)
+            cout << "Bob cannot join the CS301 waitlist without its prerequisites" << endl;
+
+        TranscriptEngine transcripts;
+        transcripts.registerStudent(&u);
+        Course algebra("MATH202", "Linear Algebra", 4, "Matrix theory");
+        transcripts.setGrade(u, c, "2024-Fall", 92);
+        transcripts.setGrade(u, algebra, "2024-Fall", 75);
+        transcripts.setGrade(u, algebra, "2024-Fall", 85); // regrade adjusts the totals in place
+        cout << "Alice GPA: " << u.getGPA() << " over " << transcripts.getCredits("S123") << " credits" << endl;
+
+        GradeHistory history;
+        history.append("S123", "MATH202", "2024-Fall", 75);
+        history.append("S123", "MATH202", "2024-Fall", 85); // regrade appeal keeps the original entry
+        history.append("S124", "CS101", "2024-Fall", 68.5);
+        history.closeTerm("2024-Fall");
+        history.append("S123", "CS201", "2025-Spring", 91);
+        history.forEachForStudent("S123", [&history](const GradeHistory::Event& e) {
+            cout << "History S123: " << history.termName(e.term) << " " << history.courseCode(e.course)
+                 << " " << e.score << endl;
+        });
+
+        BatchResult<void> upload = gb.addGrades({ {"S124", 77}, {"S125", 140}, {"S126", -5} });
+        upload.report.print(cout);
+        for (const auto& err : upload.report.errors)
+            cout << "Row " << err.row << ": " << errorCodeName(err.code) << endl;
+
+        vector<tuple<string, int, string, string, string, string, string>> hires = {
+            make_tuple("Dr. Kim", 44, "P124", "kim@email.com", "Science", "Chemistry", "2016"),
+            make_tuple("Dr. Ray", 51, "P125", "ray-at-email", "Science", "Physics", "2009")
+        };
+        BatchResult<unique_ptr<FullProfessor>> created = createPeople<FullProfessor>(hires);
+        created.report.print(cout);
+
+        PersonRoster roster;
+        roster.add(u);
+        roster.add(g);
+        roster.add(ap);
+        roster.emplace<FullProfessor>("Dr. Kim", 44, "P124", "kim@email.com", "Science", "Chemistry", "2016");
+        cout << "Roster of " << roster.size() << " owes $" << roster.totalPayment() << ", invalid rows: "
+             << roster.validate().failed() << endl;
+
         cout << "University System Initialized." << endl;
     } catch (UniversitySystemException& e) {
         cerr << "Error: " << e.what() << endl;